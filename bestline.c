@@ -98,6 +98,7 @@
 │   CTRL-SPACE     SET MARK                                                    │
 │   CTRL-X CTRL-X  GOTO MARK                                                   │
 │   PROTIP         REMAP CAPS LOCK TO CTRL                                     │
+│   CUSTOMIZE      SEE bestlineBindKey()                                       │
 │                                                                              │
 ╞══════════════════════════════════════════════════════════════════════════════╡
 │                                                                              │
@@ -154,6 +155,13 @@
 #include <sys/types.h>
 #include <termios.h>
 #include <unistd.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 #ifndef SIGWINCH
 #define SIGWINCH 28 /* GNU/Systemd + XNU + FreeBSD + NetBSD + OpenBSD */
 #endif
@@ -175,6 +183,18 @@ Copyright 2010-2013 Pieter Noordhuis <pcnoordhuis@gmail.com>\"");
 #define BESTLINE_MAX_HISTORY 1024
 #endif
 
+#ifndef BESTLINE_MAX_HINTS
+#define BESTLINE_MAX_HINTS 8
+#endif
+
+#ifndef BESTLINE_MAX_READAHEAD
+#define BESTLINE_MAX_READAHEAD 4096
+#endif
+
+#ifndef BESTLINE_PASTE_BURST
+#define BESTLINE_PASTE_BURST 32 /* bytes read ahead that mean a paste */
+#endif
+
 #define BESTLINE_HISTORY_PREV +1
 #define BESTLINE_HISTORY_NEXT -1
 
@@ -206,6 +226,113 @@ struct bestlineRing {
     char *p[BESTLINE_MAX_RING];
 };
 
+/* bytes read from an input descriptor that haven't been consumed */
+struct bestlineReadAhead {
+    int fd; /* descriptor the bytes came from */
+    unsigned i; /* index of next byte */
+    unsigned n; /* number of bytes in b */
+    unsigned cap; /* size of b, which grows up to BESTLINE_MAX_READAHEAD */
+    char *b;
+};
+
+/* Keymaps are flat tables with a slot for each modifier combination of
+ * every ascii key and special key, plus one slot shared by all other
+ * code points. Slots hold a command, or kKeymapPrefix | index of the
+ * keymap that the next keystroke of a chord gets looked up in. */
+enum {
+    kKeyRune = 128 + BESTLINE_KEY_UNKNOWN - BESTLINE_KEY_UP + 1,
+    kKeymapSlots = (kKeyRune + 1) * 8,
+    kKeymapPrefix = 0x8000,
+    kKeymapCtrlX = 1,
+    kKeymapCtrlC = 2
+};
+
+/* what the hints callback said for a recent line */
+struct bestlineHint {
+    unsigned long used; /* tick of last lookup, or 0 if empty */
+    unsigned long long hash; /* of the line */
+    unsigned len; /* length of the line */
+    char none; /* if the callback returned null */
+    struct abuf data; /* line, hint, ansi1 and ansi2, nul separated */
+};
+
+/* The bestlineLayout structure caches where things go on the screen so
+ * that refreshing doesn't need to rescan the whole line. Column widths
+ * are stored per byte of the buffer, which means editing only needs to
+ * invalidate what comes after the edit position. */
+struct bestlineLayout {
+    unsigned plen; /* length of prompt */
+    unsigned pwidth; /* monospace width of prompt */
+    unsigned valid; /* col[0,valid] is known to be correct */
+    unsigned end; /* col[0,end] was computed and col[end] is total */
+    unsigned wides; /* number of wide runes in buf[0,end) */
+    unsigned colcap; /* capacity of col */
+    unsigned *col; /* width of buf[0,i) or -1 if i is inside a rune */
+    unsigned xn; /* terminal columns the rows were wrapped for */
+    unsigned x0; /* column at which the first row begins */
+    unsigned rend; /* row breaks are known for buf[row[0],rend) */
+    unsigned nrows; /* number of rows whose start is known */
+    unsigned rowcap; /* capacity of row */
+    unsigned *row; /* buf offset of first rune on each row */
+    unsigned brkcap; /* capacity of brk */
+    unsigned *brk; /* bit i is set if a grapheme cluster starts at buf[i] */
+    unsigned runcap; /* capacity of run */
+    unsigned *run; /* brk split by class of cluster, four words per word */
+};
+
+/* The bestlineHighlights structure caches what the highlight callback
+ * said about the line, along with checkpoints where its lexer can pick
+ * up again, so an edit only needs the rest of the line highlighted. */
+struct bestlineSpan {
+    unsigned start; /* first byte of span */
+    unsigned end; /* byte after span */
+    unsigned style; /* index of sgr parameters in styles, plus one */
+};
+
+struct bestlineCheckpoint {
+    unsigned pos; /* byte at which lexer can resume */
+    unsigned long state; /* lexer state at pos */
+};
+
+struct bestlineHighlights {
+    char done; /* spans are known for buf[0,len) */
+    unsigned valid; /* spans are known to be correct for buf[0,valid) */
+    unsigned resume; /* where the callback was last asked to start */
+    unsigned len; /* length of line the callback was last asked about */
+    unsigned n; /* number of spans */
+    unsigned cap; /* capacity of span */
+    struct bestlineSpan *span; /* sorted, not overlapping */
+    unsigned nck; /* number of checkpoints */
+    unsigned ckcap; /* capacity of ck */
+    struct bestlineCheckpoint *ck; /* sorted by pos */
+};
+
+/* The bestlineFrame structure remembers what was drawn to the terminal
+ * by the last refresh, so the next one only needs to send what changed.
+ * Each cell is a rune of the line, or the whole prompt, or the whole hint,
+ * since the latter two are opaque strings that may contain ansi codes. */
+struct bestlineCell {
+    unsigned i; /* offset of glyph in text */
+    unsigned n; /* length of glyph in bytes */
+    unsigned w; /* columns taken by glyph */
+    unsigned a; /* kCellBold | kCellHead | kCellHint | style << kCellStyle */
+};
+
+struct bestlineFrame {
+    char valid; /* cells are known to be what's on the screen */
+    unsigned xn; /* terminal columns the frame was drawn for */
+    unsigned rows; /* number of rows */
+    unsigned cy; /* cursor row relative to the first row */
+    unsigned cx; /* cursor column */
+    unsigned ncells; /* number of cells */
+    unsigned attrs; /* attributes of all cells or'd together */
+    unsigned cellcap; /* capacity of cell */
+    struct bestlineCell *cell; /* what's drawn on each row in order */
+    unsigned rowcap; /* capacity of row */
+    unsigned *row; /* index of first cell on each row, then ncells */
+    struct abuf text; /* glyph bytes of cells */
+};
+
 /* The bestlineState structure represents the state during line editing.
  * We pass this state to functions implementing specific editing
  * functionalities. */
@@ -216,17 +343,36 @@ struct bestlineState {
     char *buf; /* edited line buffer */
     const char *prompt; /* prompt to display */
     int hindex; /* history index */
-    int rows; /* rows being used */
-    int oldpos; /* previous refresh cursor position */
     unsigned buflen; /* edited line buffer size */
     unsigned pos; /* current buffer index */
     unsigned len; /* current edited line length */
     unsigned mark; /* saved cursor position */
+    unsigned vstart; /* first byte shown when line is too long */
     unsigned yi, yj; /* boundaries of last yank */
-    char seq[2][16]; /* keystroke history for yanking code */
+    struct bestlineKey key; /* what the last keystroke read means */
+    unsigned lastcmd; /* command that handled the previous keystroke */
+    int keymap; /* prefix map awaiting the rest of a chord, or 0 */
+    signed char done; /* commands set 1 to accept line, or -1 for eof */
+    char again; /* commands set this if they read a key to dispatch */
     char final; /* set to true on last update */
     char dirty; /* if an update was squashed */
+    unsigned long long drawn; /* microsecond the last frame was sent */
+    unsigned long cost; /* microseconds the last complete refresh took */
     struct abuf full; /* used for multiline mode */
+    struct bestlineLayout lay; /* cached widths and row breaks */
+    struct bestlineFrame shown; /* what's currently on the screen */
+    struct bestlineFrame next; /* scratch space for the next refresh */
+    struct abuf out; /* terminal codes for the last refresh */
+    unsigned sent; /* how many bytes of out the terminal accepted */
+    struct bestlineHighlights hl; /* cached syntax highlighting */
+    unsigned long hintgen; /* generation posted to async hints, or 0 */
+    struct abuf hint; /* async hint for hintgen, then its two colors */
+};
+
+/* what bestlinePostHint() sends through the pipe before the strings */
+struct bestlineHintHeader {
+    unsigned long gen;
+    unsigned short n[3];
 };
 
 static const char *const kUnsupported[] = {"dumb", "cons25", "emacs"};
@@ -239,10 +385,25 @@ static char maskmode;
 static char emacsmode;
 static char llamamode;
 static char balancemode;
+static char smartcase;
 static char ispaused;
 static char iscapital;
+static char syncquery;
+static char syncmode;
+static char slowlink;
+static char lowbandwidth; /* 0 automatic, 1 off, 2 on */
 static unsigned historylen;
+static unsigned long frameinterval; /* plus one, or 0 for default */
+static unsigned long renderbudget; /* plus one, or 0 for default */
+static unsigned long degradedframes;
+static unsigned long hintsgen;
+static unsigned long hintstick;
+static char hintsnocache;
+static char hintsopen; /* if hintsfd is a pipe */
+static int hintsfd[2];
 static struct bestlineRing ring;
+static struct bestlineHint hints[BESTLINE_MAX_HINTS];
+static struct bestlineReadAhead inbufs[4];
 static struct sigaction orig_cont;
 static struct sigaction orig_winch;
 static struct termios orig_termios;
@@ -250,10 +411,20 @@ static char *history[BESTLINE_MAX_HISTORY];
 static bestlineXlatCallback *xlatCallback;
 static bestlineHintsCallback *hintsCallback;
 static bestlineFreeHintsCallback *freeHintsCallback;
+static bestlineAsyncHintsCallback *asyncHintsCallback;
 static bestlineCompletionCallback *completionCallback;
+static bestlineHighlightCallback *highlightCallback;
+static unsigned nstyles;
+static unsigned stylecap;
+static char **styles;
+static unsigned nkeymaps;
+static unsigned short (*keymaps)[kKeymapSlots];
+static unsigned ncommands;
+static bestlineCommandCallback **commands;
 
 static void bestlineAtExit(void);
 static void bestlineRefreshLine(struct bestlineState *);
+static void bestlineRefreshLineForce(struct bestlineState *);
 
 static void bestlineOnInt(int sig) {
     gotint = sig;
@@ -271,6 +442,1489 @@ static char IsControl(unsigned c) {
     return c <= 0x1F || (0x7F <= c && c <= 0x9F);
 }
 
+/* BEGIN GENERATED UNICODE TABLES (make unicode-tables) */
+static const unsigned char kWidthStage1[0x110] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x05, 0x05, 0x05, 0x05, 0x06, 0x05, 0x05, 0x07, 0x08, 0x09,
+    0x0a, 0x0b, 0x08, 0x0c, 0x08, 0x08, 0x0d, 0x05, 0x0e, 0x08, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14,
+    0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x15,
+    0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x15,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x16, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+};
+
+static const unsigned char kWidthStage2[23][64] = {
+    {0x00, 0x01, 0x00, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x03, 0x04, 0x02, 0x02,
+     0x02, 0x02, 0x05, 0x02, 0x02, 0x02, 0x06, 0x07, 0x08, 0x09, 0x02, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+     0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x17, 0x19, 0x1a, 0x1b, 0x1c, 0x1d,
+     0x1e, 0x1f, 0x1a, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c},
+    {0x2d, 0x2e, 0x2f, 0x02, 0x30, 0x31, 0x03, 0x03, 0x02, 0x02, 0x02, 0x02, 0x02, 0x32, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x33, 0x34, 0x35, 0x36,
+     0x37, 0x02, 0x38, 0x02, 0x39, 0x02, 0x02, 0x02, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f, 0x40, 0x41,
+     0x42, 0x02, 0x02, 0x43, 0x02, 0x02, 0x02, 0x03, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02},
+    {0x44, 0x45, 0x02, 0x46, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x47, 0x02, 0x02, 0x48,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f, 0x50, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x51, 0x52, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x53, 0x02, 0x01, 0x02, 0x54, 0x02, 0x02, 0x55, 0x56, 0x30, 0x30, 0x30, 0x57},
+    {0x58, 0x59, 0x5a, 0x30, 0x5b, 0x30, 0x5c, 0x5d, 0x5e, 0x5f, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+     0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+     0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+     0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30},
+    {0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+     0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+     0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+     0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x02, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30},
+    {0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+     0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+     0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+     0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30},
+    {0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+     0x30, 0x30, 0x60, 0x61, 0x02, 0x02, 0x02, 0x02, 0x02, 0x62, 0x63, 0x64, 0x02, 0x02, 0x02, 0x02,
+     0x65, 0x02, 0x02, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x02, 0x02, 0x02, 0x6f,
+     0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30},
+    {0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+     0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x70, 0x71,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02},
+    {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02},
+    {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x72, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x73, 0x74, 0x02, 0x01, 0x59, 0x75, 0x02, 0x76},
+    {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x77, 0x02, 0x02, 0x02, 0x78, 0x02, 0x79, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x7a, 0x02, 0x02, 0x7b, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x7c, 0x02, 0x02, 0x02, 0x02, 0x02, 0x7d, 0x02, 0x02, 0x7e, 0x7f, 0x02},
+    {0x80, 0x81, 0x82, 0x1c, 0x83, 0x84, 0x85, 0x86, 0x87, 0x02, 0x02, 0x88, 0x21, 0x89, 0x02, 0x02,
+     0x8a, 0x8b, 0x8c, 0x8d, 0x02, 0x02, 0x8e, 0x8f, 0x90, 0x91, 0x92, 0x02, 0x93, 0x02, 0x02, 0x02,
+     0x94, 0x02, 0x02, 0x02, 0x95, 0x96, 0x02, 0x97, 0x98, 0x99, 0x9a, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x9b, 0x02, 0x9c, 0x02, 0x9d, 0x9e, 0x9f, 0x02, 0x02, 0x02, 0x02, 0xa0, 0x02, 0x02, 0x02, 0x02},
+    {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0xa1, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02},
+    {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0xa2, 0xa3, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0xa4, 0xa5, 0xa6},
+    {0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+     0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xa7,
+     0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+     0x30, 0x30, 0x30, 0xa8, 0xa9, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02},
+    {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0xaa},
+    {0x30, 0x30, 0x30, 0x30, 0xab, 0xac, 0x30, 0x30, 0x30, 0x30, 0x30, 0xad, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0xae, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02},
+    {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0xaf, 0xb0, 0x02, 0x02},
+    {0x02, 0x02, 0x02, 0x02, 0x02, 0xb1, 0xb2, 0x02, 0x02, 0xb3, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0xb4, 0xb5, 0xb6, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02},
+    {0xb7, 0x02, 0x02, 0x02, 0xa3, 0x02, 0x02, 0x02, 0x02, 0x02, 0xb8, 0xb9, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0xba, 0x02, 0xbb, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02},
+    {0xbc, 0x02, 0x02, 0xbd, 0x02, 0x02, 0xbe, 0x02, 0xbf, 0xc0, 0x02, 0x02, 0xc1, 0xc2, 0xc3, 0xc4,
+     0xc5, 0xc6, 0x30, 0xc7, 0xc8, 0xc9, 0xca, 0xcb, 0x30, 0xcc, 0x30, 0xcd, 0x02, 0x02, 0x02, 0xce,
+     0x02, 0x02, 0x02, 0x02, 0xcf, 0xd0, 0x30, 0x30, 0x02, 0xd1, 0xd2, 0xd3, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02},
+    {0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+     0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+     0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+     0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xc8},
+    {0xd4, 0x03, 0x02, 0x02, 0x03, 0x03, 0x03, 0x04, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02},
+};
+
+static const unsigned char kWidthStage3[213][16] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55},
+    {0x15, 0x00, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10},
+    {0x41, 0x10, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x40, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x15, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0x54, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x14, 0x00, 0x14, 0x04, 0x50, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x00, 0x54, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x55, 0x55, 0x51},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x10, 0x00, 0x00, 0x01, 0x01, 0x50, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x54},
+    {0x01, 0x00, 0x54, 0x51, 0x01, 0x00, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54},
+    {0x01, 0x54, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45},
+    {0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54},
+    {0x41, 0x15, 0x14, 0x50, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x51, 0x55, 0x55},
+    {0x01, 0x10, 0x54, 0x51, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00},
+    {0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x14},
+    {0x01, 0x54, 0x55, 0x51, 0x55, 0x41, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x54, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x54, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x04},
+    {0x54, 0x05, 0x04, 0x50, 0x55, 0x41, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x45, 0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x54},
+    {0x01, 0x54, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x45, 0x55, 0x05, 0x44, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x00, 0x40, 0x55},
+    {0x55, 0x15, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x00, 0x00, 0x54},
+    {0x55, 0x55, 0x00, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x11, 0x51, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x00, 0x00, 0x40},
+    {0x00, 0x04, 0x55, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x54},
+    {0x55, 0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x04, 0x00, 0x41, 0x41},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x05, 0x54, 0x55, 0x55, 0x55, 0x01, 0x54, 0x55, 0x55},
+    {0x45, 0x41, 0x55, 0x51, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x05, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x10, 0x00, 0x50},
+    {0x55, 0x45, 0x01, 0x00, 0x00, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x15, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x40, 0x15, 0x54, 0x55, 0x45, 0x55, 0x01, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x14, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x00, 0x40, 0x44, 0x01, 0x00, 0x54, 0x15, 0x00, 0x00, 0x14},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x04, 0x40, 0x54},
+    {0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x55, 0x55, 0x55},
+    {0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x50, 0x10, 0x50, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x50, 0x11, 0x50, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x05, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x40, 0x00, 0x00, 0x00, 0x04, 0x00, 0x54, 0x51, 0x55, 0x54, 0x50, 0x55},
+    {0x55, 0x55, 0x15, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x40, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x04, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x54, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xa5, 0x55, 0x55, 0x55, 0x69, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xa9, 0x56, 0x96, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x69},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x5a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x95},
+    {0x55, 0x55, 0x55, 0x55, 0x95, 0x55, 0x55, 0x55, 0x59, 0x55, 0xa5, 0x55, 0x55, 0x55, 0x55, 0x69},
+    {0x55, 0x5a, 0x55, 0x65, 0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x65, 0x55, 0xa5, 0x59, 0x65, 0x59},
+    {0x55, 0x59, 0xa5, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x66, 0x95, 0x9a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0xa9, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x56, 0x55, 0x55, 0x95},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x95, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x56, 0x59, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x50, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x9a, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x5a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0x55},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x0a, 0xa0, 0xaa, 0xaa, 0xaa, 0x6a},
+    {0xa9, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0x81, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa},
+    {0x55, 0xa9, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xa9, 0xaa, 0xaa, 0xaa},
+    {0xaa, 0xaa, 0xaa, 0x6a, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa},
+    {0xaa, 0xaa, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa},
+    {0xaa, 0xaa, 0xaa, 0x56, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa},
+    {0xaa, 0x6a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x40, 0x00, 0x00, 0x50},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55},
+    {0x45, 0x45, 0x15, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x41, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x50, 0x55, 0x55, 0x15},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x50, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x15, 0x00, 0x00, 0x50, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x56},
+    {0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x05, 0x50, 0x50},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x40, 0x41, 0x41, 0x55, 0x55},
+    {0x15, 0x55, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x04, 0x14, 0x54, 0x05},
+    {0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x45, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x54, 0x51, 0x55, 0x55, 0x55, 0x55},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x40, 0x15, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x00, 0x00, 0x00, 0x00, 0xaa, 0xaa, 0x5a, 0x55, 0x00, 0x00, 0x00, 0x00, 0xaa, 0xaa, 0xaa, 0xaa},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0xaa, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xaa, 0x6a, 0x55, 0x55, 0x55, 0x55, 0x01, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x40, 0x55},
+    {0x01, 0x41, 0x55, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x40, 0x15},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x54, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x05, 0x00, 0x00, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x05, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00},
+    {0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x14, 0x54, 0x55, 0x15},
+    {0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x40, 0x41, 0x55},
+    {0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x01, 0x00, 0x54, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x55, 0x55, 0x55},
+    {0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x40},
+    {0x55, 0x55, 0x01, 0x14, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x50, 0x04, 0x55, 0x45},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x15, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x54, 0x00, 0x54, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00},
+    {0x05, 0x44, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x44, 0x15},
+    {0x04, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x50, 0x55, 0x10},
+    {0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x40, 0x11},
+    {0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x51, 0x00, 0x10, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x05, 0x10, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x41, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x44},
+    {0x15, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x05, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x01, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x14, 0x40},
+    {0x55, 0x15, 0x55, 0x55, 0x01, 0x40, 0x01, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x05, 0x00, 0x00, 0x40, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x40, 0x00, 0x10},
+    {0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x04, 0x41, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x40, 0x45, 0x10},
+    {0x00, 0x10, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x50, 0x11, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x54, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x54, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x54, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x40, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x15, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x15, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xaa, 0x54, 0x55, 0x55, 0x5a, 0x55, 0x55, 0x55},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0x55},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x5a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0xaa, 0xaa, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xaa, 0xa9, 0xaa, 0x69},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x6a, 0x55, 0x55, 0x55, 0x55, 0xaa, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x41, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x50, 0x55, 0x15, 0x00, 0x00, 0x00},
+    {0x40, 0x01, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x50, 0x55, 0x55, 0x55, 0x55},
+    {0x05, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x15, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x54, 0x55, 0x51, 0x55, 0x55},
+    {0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x01, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55},
+    {0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x14, 0x00, 0x10, 0x04, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x95, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x65, 0xa9, 0xaa, 0x6a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x6a, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55},
+    {0xaa, 0xaa, 0x56, 0x55, 0x5a, 0x55, 0x55, 0x55, 0xaa, 0x5a, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x56, 0x55, 0x55, 0xa9, 0xaa, 0x9a, 0xaa, 0xaa},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xa6},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa},
+    {0xaa, 0xaa, 0x6a, 0x95, 0xaa, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa, 0x56, 0x56, 0xaa, 0xaa},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a},
+    {0xa6, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x96},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x5a},
+    {0x55, 0x55, 0x95, 0x6a, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55, 0x55, 0x65, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x69, 0x55, 0x55, 0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x95, 0xaa},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+    {0xaa, 0x5a, 0x55, 0x56, 0x6a, 0xa9, 0x55, 0xa9, 0x55, 0x55, 0x95, 0x56, 0x55, 0xaa, 0xaa, 0x56},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0x55, 0x56, 0x55, 0x55, 0x55},
+    {0x55, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x6a, 0xaa},
+    {0xaa, 0x9a, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa},
+    {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xaa, 0x56, 0xaa, 0x56},
+    {0xaa, 0x6a, 0x55, 0x55, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0x56, 0xaa, 0xaa, 0x6a, 0x55},
+    {0xaa, 0x5a, 0x55, 0x55, 0xaa, 0xaa, 0x5a, 0x55, 0xaa, 0xaa, 0x55, 0x55, 0xaa, 0x6a, 0x55, 0x55},
+    {0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+};
+
+static const unsigned char kWordStage1[0x110] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x05, 0x04, 0x04, 0x06, 0x07, 0x08,
+    0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x07, 0x0e, 0x04, 0x0f, 0x07, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x16, 0x17, 0x18, 0x04, 0x19, 0x1a,
+    0x04, 0x1b, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+    0x1c, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+};
+
+static const unsigned char kWordStage2[29][32] = {
+    {0x00, 0x01, 0x02, 0x02, 0x02, 0x03, 0x04, 0x05, 0x02, 0x02, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b,
+     0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b},
+    {0x1c, 0x1d, 0x02, 0x02, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x02, 0x02, 0x02, 0x23, 0x24, 0x25, 0x26,
+     0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x02, 0x02, 0x02, 0x02, 0x31, 0x32},
+    {0x33, 0x34, 0x35, 0x36, 0x37, 0x37, 0x38, 0x39, 0x3a, 0x02, 0x02, 0x3b, 0x3c, 0x02, 0x3d, 0x3e,
+     0x02, 0x02, 0x37, 0x37, 0x37, 0x37, 0x3f, 0x40, 0x02, 0x41, 0x42, 0x43, 0x44, 0x45, 0x02, 0x46},
+    {0x47, 0x48, 0x49, 0x4a, 0x4b, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02},
+    {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02},
+    {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x4c, 0x02, 0x02, 0x4d, 0x4e, 0x4f, 0x50,
+     0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02},
+    {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x59,
+     0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37},
+    {0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37,
+     0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37},
+    {0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37,
+     0x37, 0x37, 0x02, 0x02, 0x5a, 0x5b, 0x5c, 0x5d, 0x02, 0x02, 0x5e, 0x5f, 0x60, 0x61, 0x62, 0x63},
+    {0x64, 0x65, 0x66, 0x67, 0x37, 0x68, 0x69, 0x6a, 0x02, 0x6b, 0x6c, 0x6d, 0x02, 0x02, 0x6e, 0x6f,
+     0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x37, 0x7b, 0x7c, 0x7d, 0x7e},
+    {0x7f, 0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x37, 0x86, 0x87, 0x37, 0x88, 0x89, 0x8a, 0x8b, 0x37,
+     0x8c, 0x8d, 0x8e, 0x8f, 0x90, 0x91, 0x37, 0x37, 0x92, 0x93, 0x94, 0x95, 0x37, 0x96, 0x37, 0x97},
+    {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x98, 0x99, 0x02, 0x9a, 0x37, 0x37, 0x37, 0x37, 0x37,
+     0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x9b},
+    {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x9c, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37,
+     0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37},
+    {0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x02, 0x02, 0x02, 0x02, 0x9d, 0x37, 0x37, 0x37,
+     0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37},
+    {0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37,
+     0x02, 0x02, 0x02, 0x02, 0x9e, 0x9f, 0xa0, 0xa1, 0x37, 0x37, 0x37, 0x37, 0xa2, 0xa3, 0xa4, 0xa5},
+    {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0xa6,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0xa7, 0xa8, 0x37, 0x37, 0x37, 0x37, 0x37},
+    {0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37,
+     0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0xa9},
+    {0x02, 0x02, 0xaa, 0x02, 0x02, 0xab, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37,
+     0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0xac, 0xad, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37},
+    {0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37,
+     0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0xae, 0x9a},
+    {0x02, 0xaf, 0xb0, 0xb1, 0xb2, 0xb3, 0xb4, 0x37, 0xb5, 0xb6, 0xb7, 0x02, 0x02, 0xb8, 0xb9, 0xba,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0xbb, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0xbc, 0x37},
+    {0xbd, 0x37, 0xbe, 0x37, 0x37, 0xbf, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0xc0,
+     0x02, 0xc1, 0xc2, 0x37, 0x37, 0x37, 0x37, 0x37, 0xc3, 0xc4, 0xc5, 0x37, 0xc6, 0xc7, 0x37, 0x37},
+    {0xc8, 0xc9, 0x02, 0xca, 0xcb, 0x37, 0x02, 0x65, 0x02, 0x02, 0x02, 0x02, 0x02, 0xcc, 0x2e, 0xcd,
+     0xce, 0xcf, 0x02, 0x02, 0xd0, 0xd1, 0x02, 0xd2, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37},
+    {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0xd3, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02},
+    {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0xd4, 0x02,
+     0xd5, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02},
+    {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0xd6, 0x02, 0x02},
+    {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+     0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0xd7, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37},
+    {0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37,
+     0x02, 0x02, 0x02, 0x02, 0xd8, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37},
+    {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0xd9, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37,
+     0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37},
+    {0x37, 0x37, 0x02, 0xda, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37,
+     0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37},
+};
+
+static const unsigned char kWordStage3[219][16] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x03, 0xfe, 0xff, 0xff, 0x07, 0xfe, 0xff, 0xff, 0x07},
+    {0x00, 0x00, 0x00, 0x00, 0x40, 0x46, 0x2d, 0x76, 0xff, 0xff, 0x7f, 0xff, 0xff, 0xff, 0x7f, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc3, 0xff, 0x03, 0x00, 0x1f, 0x50, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xbc},
+    {0x40, 0xd7, 0xff, 0xff, 0xfb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0xff, 0xff, 0xff, 0x7f, 0x02, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0x61, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xb6, 0x00, 0xff, 0xff, 0xff, 0x87, 0x07, 0x00},
+    {0x00, 0xc0, 0xff, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc3, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xdf, 0xff, 0xff, 0xff, 0xff},
+    {0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x03, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0x24},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x00, 0x00, 0xff, 0xff, 0xff, 0x0f, 0xff, 0x07, 0xff, 0xff},
+    {0xff, 0x7e, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfb, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xcf, 0xff, 0xfe, 0xff},
+    {0xef, 0x9f, 0xf9, 0xff, 0xff, 0xfd, 0xc5, 0xf3, 0x9f, 0x79, 0x80, 0xb0, 0xcf, 0xff, 0xf3, 0x57},
+    {0xee, 0x87, 0xf9, 0xff, 0xff, 0xfd, 0x6d, 0xd3, 0x87, 0x39, 0x02, 0x5e, 0xc0, 0xff, 0x3f, 0x00},
+    {0xee, 0xbf, 0xfb, 0xff, 0xff, 0xfd, 0xed, 0xf3, 0xbf, 0x3b, 0x01, 0x00, 0xcf, 0xff, 0x00, 0xfe},
+    {0xee, 0x9f, 0xf9, 0xff, 0xff, 0xfd, 0xed, 0xf3, 0x9f, 0x39, 0xe0, 0xb0, 0xcf, 0xff, 0xff, 0x00},
+    {0xec, 0xc7, 0x3d, 0xd6, 0x18, 0xc7, 0xff, 0xc3, 0xc7, 0x3d, 0x81, 0x00, 0xc0, 0xff, 0xff, 0x05},
+    {0xff, 0xdf, 0xfd, 0xff, 0xff, 0xfd, 0xff, 0xf3, 0xdf, 0x3d, 0x60, 0x27, 0xcf, 0xff, 0x00, 0xff},
+    {0xef, 0xdf, 0xfd, 0xff, 0xff, 0xfd, 0xef, 0xf3, 0xdf, 0x3d, 0x60, 0x60, 0xcf, 0xff, 0x06, 0x00},
+    {0xff, 0xdf, 0xfd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xfd, 0xf0, 0xff, 0xcf, 0xff, 0xff, 0xff},
+    {0xee, 0xff, 0x7f, 0xfc, 0xff, 0xff, 0xfb, 0x2f, 0x7f, 0x84, 0x5f, 0xff, 0xc0, 0xff, 0x0c, 0x00},
+    {0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0xff, 0x7f, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00},
+    {0xd6, 0xf7, 0xff, 0xff, 0xaf, 0xff, 0xff, 0x3f, 0x5f, 0x3f, 0xff, 0xf3, 0x00, 0x00, 0x00, 0x00},
+    {0x0f, 0x00, 0xe8, 0xff, 0xff, 0xff, 0xff, 0xc3, 0xff, 0xfe, 0xff, 0xff, 0xff, 0x1f, 0xfe, 0xff},
+    {0xdf, 0xff, 0xff, 0xfe, 0xff, 0xff, 0xff, 0xdf, 0xff, 0xdf, 0xe0, 0x01, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x03, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0x20, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3d, 0x7f, 0x3d, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0x3d, 0xff, 0xff, 0xff, 0xff, 0x3d, 0x7f, 0x3d, 0xff, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0x3d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x00, 0xfe, 0xff, 0x1f},
+    {0xff, 0xff, 0xff, 0x03, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x3f},
+    {0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff},
+    {0xfe, 0xff, 0xff, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc7, 0xff, 0x01},
+    {0xff, 0xff, 0x3f, 0x80, 0xff, 0xff, 0x1f, 0x00, 0xff, 0xff, 0x0f, 0x00, 0xff, 0xdf, 0x0d, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x8f, 0x30, 0xff, 0x03, 0xff, 0x03},
+    {0x00, 0xb8, 0xff, 0x03, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x00},
+    {0xff, 0xff, 0xff, 0x7f, 0xff, 0x0f, 0xff, 0x0f, 0xc1, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x1f, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0x0f, 0xff, 0xff, 0xff, 0x03, 0xff, 0xc7, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xff, 0xff, 0xff, 0x9f},
+    {0xff, 0x03, 0xff, 0x03, 0x80, 0x00, 0xff, 0xff, 0xff, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1f, 0xff, 0x03, 0xfe, 0xff, 0xff, 0x1f},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0f, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0xff, 0xe3, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f},
+    {0xff, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0x00, 0x00, 0xf7, 0xff, 0xff, 0xff, 0xff, 0x07},
+    {0xff, 0xff, 0x3f, 0x3f, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x3f, 0xff, 0xaa, 0xff, 0xff, 0xff, 0x3f},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0x5f, 0xdc, 0x1f, 0xcf, 0x0f, 0xff, 0x1f, 0xdc, 0x1f},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf3, 0x83},
+    {0xff, 0x03, 0xff, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00},
+    {0xff, 0xff, 0xff, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xe0, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0x0f, 0xe0, 0xf3, 0xb6, 0xbf, 0xff, 0xff, 0xff, 0x3f, 0xeb, 0xff, 0xff, 0xff, 0x0f, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xf0, 0xff, 0xff, 0xfc, 0xf9, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef},
+    {0xff, 0xff, 0xff, 0x07, 0x00, 0x00, 0xf0, 0xff, 0xff, 0xff, 0xff, 0x0f, 0xfc, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0x7f, 0x00, 0x00, 0x00, 0xff, 0x07, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xff, 0xfd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0xc0, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x60, 0xe0, 0xff, 0xff, 0xff, 0xff, 0xcf, 0xff},
+    {0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0f, 0x20},
+    {0xff, 0xff, 0xff, 0xff, 0xbf, 0x20, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x80, 0x00, 0x80},
+    {0xff, 0xff, 0x7f, 0x00, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0xff, 0xff, 0xff, 0xff},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xfb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0f, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x00, 0x00, 0x00, 0xff, 0x0f},
+    {0xf0, 0x00, 0x0c, 0x00, 0xff, 0xff, 0xfe, 0xdf, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0x7f, 0xe6, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7},
+    {0xe0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0f, 0x00, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0x1f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f},
+    {0xff, 0x1f, 0xff, 0xff, 0xff, 0x0f, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbf},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x03, 0x00},
+    {0x00, 0x00, 0x80, 0xff, 0xfc, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xf9, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0xeb, 0x03, 0x00, 0x00, 0xfc, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0x1f, 0xff, 0x02, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0f, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x00, 0xff, 0x03, 0xff, 0xff, 0xff, 0xe8},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xff, 0xff, 0xff, 0xff, 0x0f, 0x00, 0xff, 0xff, 0xff, 0x1f},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x80, 0xff, 0x03, 0xff, 0xff, 0xff, 0x7f},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0x00, 0xff, 0x3f, 0xff, 0x03, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0x00, 0x00, 0x38, 0xff, 0xff, 0x7c, 0x00},
+    {0x7e, 0x7e, 0x7e, 0x00, 0x7f, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xff, 0x03, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x37, 0xff, 0x03},
+    {0xff, 0xff, 0xff, 0xff, 0x0f, 0x00, 0xff, 0xff, 0x7f, 0xf8, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0f},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00},
+    {0x7f, 0x00, 0xf8, 0xe0, 0xff, 0xfd, 0x7f, 0x5f, 0xdb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x03, 0x00, 0x00, 0x00, 0xf8, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xfc, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x80, 0x00, 0x00, 0x00, 0x00, 0xff, 0xef},
+    {0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xdf, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1f},
+    {0x00, 0x00, 0xff, 0x03, 0xfe, 0xff, 0xff, 0x07, 0xfe, 0xff, 0xff, 0x07, 0xc0, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xfc, 0xfc, 0xfc, 0x1c, 0x10, 0x61, 0x00, 0x30},
+    {0xff, 0xef, 0xff, 0xff, 0x7f, 0xff, 0xff, 0xb7, 0xff, 0x3f, 0xff, 0x3f, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07},
+    {0x80, 0xff, 0xff, 0xff, 0xff, 0xff, 0x8f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0x7f, 0xff, 0x1f, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f},
+    {0xff, 0xff, 0xff, 0x1f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0xff, 0xff, 0xff, 0x0f},
+    {0xff, 0xff, 0xff, 0xff, 0x0f, 0xe0, 0xff, 0xff, 0xff, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07},
+    {0xff, 0xff, 0xff, 0x3f, 0xff, 0xff, 0xff, 0xff, 0x0f, 0xff, 0x3e, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0x3f, 0xff, 0x03, 0xff, 0xff, 0xff, 0xff, 0x0f, 0xff, 0xff, 0xff, 0xff, 0x0f},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0f, 0x00, 0xff, 0xf7},
+    {0xff, 0xf7, 0xb7, 0xff, 0xfb, 0xff, 0xfb, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0x00, 0xff, 0xff, 0x3f, 0x00, 0xff, 0x00, 0x00, 0x00},
+    {0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfd, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x3f, 0xfd, 0xff, 0xff, 0xff, 0xff, 0xbf, 0x91, 0xff, 0xff, 0x3f, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0x7f, 0x80, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x37, 0xf8},
+    {0xff, 0xff, 0xff, 0x0f, 0xff, 0xff, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0xff, 0xff, 0xfc, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0x6f, 0xf0, 0xef, 0xfe, 0xff, 0xff, 0x3f, 0x87, 0xff, 0x01, 0x00, 0x00, 0xff, 0xff, 0xff, 0x7f},
+    {0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xf8, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x00, 0xff, 0xff, 0x3f, 0xff, 0xff, 0xff, 0x07, 0xff},
+    {0xff, 0xff, 0x03, 0x00, 0x00, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0xfc},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x7f},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0x1b, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x00, 0x00, 0x00, 0xff, 0xff},
+    {0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x0f, 0x00, 0x00, 0xff, 0xff, 0x7f, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0x00, 0xfc, 0xff, 0xff, 0xff, 0x3f, 0x80},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0x04, 0x00, 0xff, 0xff, 0xff, 0x01, 0xff, 0x03},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xff, 0xf0, 0x00, 0xff, 0xff, 0xff, 0xff, 0x4f, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1f, 0xde, 0xff, 0x17, 0xfe, 0xff, 0x1f, 0x00},
+    {0xff, 0xff, 0xfb, 0xff, 0xff, 0xff, 0xff, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x7f, 0xbd, 0xff, 0xbf, 0xff, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0xff, 0x03},
+    {0xef, 0x9f, 0xf9, 0xff, 0xff, 0xfd, 0xed, 0xfb, 0x9f, 0x39, 0x81, 0xe0, 0xcf, 0x1f, 0x1f, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0xff, 0xc3, 0x03, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0x00, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xff, 0x01, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x11, 0x00, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xe7, 0xff, 0x0f, 0xff, 0x8f, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0x80},
+    {0x7f, 0xf2, 0x6f, 0xff, 0xff, 0xff, 0xbf, 0xf9, 0x0f, 0x00, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0xff, 0xfc, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x1b, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0x80, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0x23, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01},
+    {0xff, 0xfd, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xff, 0x01, 0x00, 0xff, 0xff, 0xff, 0x1f, 0xfc, 0xff},
+    {0xff, 0xff, 0xfc, 0xff, 0xff, 0xfe, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x7f, 0xfb, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xb4, 0xff, 0x00, 0xff, 0x03, 0xbf, 0xfd, 0xff, 0xff},
+    {0xff, 0x7f, 0xfb, 0x01, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x7f, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0xff, 0xff, 0xff, 0x1f, 0xfe, 0xff, 0x03, 0x00},
+    {0xff, 0xff, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0xff, 0xff, 0xff, 0x7f, 0xff, 0x03, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xff, 0x03, 0xff, 0xff, 0xff, 0x3f, 0x1f, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xf0, 0x2f, 0x00, 0xff, 0xfb, 0xfb, 0xff, 0xff, 0xe0},
+    {0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x87, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0x80, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1b, 0x00, 0x03, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xef, 0x6f},
+    {0xff, 0xff, 0xff, 0xff, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0xf0, 0x00, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0f},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0xff, 0x1f},
+    {0xff, 0x01, 0xff, 0x73, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xff, 0xff, 0x7f, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0x7f, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0xf8},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x0f, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0x00, 0xff, 0xff, 0xff, 0x01},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xdf, 0x64, 0xde, 0xff, 0xeb, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xbf, 0xe7, 0xdf, 0xdf, 0xff, 0xff, 0xff, 0x7b, 0x5f, 0xfc, 0xfd, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0x3f, 0xff, 0xff, 0xff, 0xfd, 0xff, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xf7},
+    {0xff, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xdf, 0xff, 0xff, 0x7f, 0xff, 0xff, 0xff, 0x7f, 0xff, 0xff},
+    {0xff, 0xfd, 0xff, 0xff, 0xff, 0xfd, 0xff, 0xff, 0xf7, 0xcf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0x7f, 0x00, 0x00, 0xf8, 0xfe, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x7f, 0xff, 0xff, 0xf9, 0xdb, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0x1f, 0xff, 0x3f, 0xff, 0xc3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xff, 0xff, 0xff, 0x7f, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x03},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0x6f, 0xff, 0x7f},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9f, 0xff, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0f, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfe, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xef, 0xff, 0xff, 0xff, 0x96, 0xfe, 0xf7, 0x0a, 0x84, 0xea, 0x96, 0xaa, 0x96, 0xf7, 0xf7, 0x5e},
+    {0xff, 0xfb, 0xff, 0x0f, 0xee, 0xfb, 0xff, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0x0f, 0x00, 0xff, 0x7f, 0xfe, 0xff, 0xfe, 0xff, 0xfe, 0xff, 0xff, 0xff, 0x3f, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0xff, 0xff, 0xff},
+    {0x07, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0f, 0xff, 0x01, 0x03, 0x00, 0x3f, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe0, 0xff, 0x1f, 0xff, 0x1f},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0xff, 0x0f, 0x01, 0x00},
+    {0xff, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0xff, 0x03, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0x00, 0xff, 0xff, 0xff, 0x3f, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0f, 0x00, 0xff, 0x3f, 0x1f, 0x1f},
+    {0x7f, 0x00, 0xff, 0xff, 0xff, 0x1f, 0xff, 0x07, 0x3f, 0x00, 0xff, 0x03, 0xff, 0x00, 0x7f, 0x00},
+    {0xff, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0x00, 0x00, 0x00, 0x00, 0xff, 0x03},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0x3f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0x03, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00},
+};
+
+static const unsigned char kDeltaStage1[0xf5] = {
+    0x00, 0x01, 0x02, 0x03, 0x03, 0x03, 0x03, 0x04, 0x05, 0x06, 0x03, 0x07, 0x03, 0x03, 0x08, 0x09,
+    0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x03, 0x0f, 0x10, 0x11, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x12, 0x03, 0x13, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x14,
+    0x03, 0x03, 0x15, 0x03, 0x03, 0x03, 0x16, 0x03, 0x03, 0x03, 0x03, 0x03, 0x17, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x18, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x19, 
+};
+
+static const unsigned char kDeltaStage2[26][32] = {
+    {0x00, 0x00, 0x01, 0x00, 0x02, 0x03, 0x04, 0x05, 0x00, 0x00, 0x00, 0x06, 0x07, 0x08, 0x09, 0x0a,
+     0x0b, 0x0b, 0x0b, 0x0c, 0x0d, 0x0b, 0x0b, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x0b, 0x15},
+    {0x0b, 0x0b, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x00, 0x1f, 0x20, 0x02, 0x21, 0x04, 0x22, 0x23, 0x0b, 0x24},
+    {0x25, 0x07, 0x07, 0x09, 0x09, 0x26, 0x0b, 0x0b, 0x27, 0x0b, 0x0b, 0x0b, 0x28, 0x0b, 0x0b, 0x0b,
+     0x0b, 0x0b, 0x0b, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x2f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0x31, 0x32, 0x32, 0x33,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x34, 0x34, 0x34, 0x34, 0x34, 0x35},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x37, 0x38, 0x38, 0x39, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3a, 0x3b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x3c, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b,
+     0x3d, 0x3e, 0x3d, 0x3d, 0x3e, 0x3f, 0x3d, 0x40, 0x3d, 0x3d, 0x3d, 0x41, 0x42, 0x43, 0x44, 0x45},
+    {0x00, 0x00, 0x00, 0x00, 0x46, 0x00, 0x00, 0x47, 0x47, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x48, 0x49, 0x4a, 0x00, 0x4b, 0x4c, 0x4d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x4e, 0x00, 0x4f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x51, 0x52, 0x53, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x54, 0x55, 0x00, 0x00, 0x00, 0x00, 0x46, 0x00, 0x56, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x57, 0x58, 0x00, 0x00, 0x00, 0x4e, 0x00, 0x59},
+    {0x2a, 0x2a, 0x2a, 0x2d, 0x2d, 0x2d, 0x5a, 0x5b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x5c, 0x5d,
+     0x5e, 0x5e, 0x5f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x60, 0x00, 0x00, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x54, 0x62, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x0b, 0x0b, 0x63, 0x00, 0x0b, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x65, 0x65, 0x0b, 0x0b, 0x0b, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x00, 0x6d},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x6e, 0x00, 0x6f, 0x6f, 0x6f, 0x6f, 0x6f, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x01, 0x00, 0x02, 0x03, 0x04, 0x71, 0x72, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x73, 0x73, 0x74, 0x75, 0x75, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0x73, 0x76, 0x75, 0x77,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x78, 0x78, 0x79, 0x7a, 0x7b, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7c, 0x7c, 0x7c, 0x7d, 0x7e, 0x7e, 0x7e, 0x7f,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x07, 0x09, 0x09, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x07, 0x07, 0x09, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x80, 0x80, 0x81, 0x82, 0x83, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+};
+
+static const unsigned char kDeltaStage3[132][16] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03},
+    {0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x04, 0x00, 0x05, 0x00, 0x00},
+    {0x00, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06},
+    {0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x04, 0x00, 0x05, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03},
+    {0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x00, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x00},
+    {0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06},
+    {0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x00, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x08},
+    {0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a},
+    {0x0b, 0x0c, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x00, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09},
+    {0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x00, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a},
+    {0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x0d, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x0e},
+    {0x0f, 0x10, 0x09, 0x0a, 0x09, 0x0a, 0x11, 0x09, 0x0a, 0x12, 0x12, 0x09, 0x0a, 0x00, 0x13, 0x14},
+    {0x15, 0x09, 0x0a, 0x12, 0x16, 0x17, 0x18, 0x19, 0x09, 0x0a, 0x1a, 0x00, 0x18, 0x1b, 0x1c, 0x1d},
+    {0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x1e, 0x09, 0x0a, 0x1e, 0x00, 0x00, 0x09, 0x0a, 0x1e, 0x09},
+    {0x0a, 0x1f, 0x1f, 0x09, 0x0a, 0x09, 0x0a, 0x20, 0x09, 0x0a, 0x00, 0x00, 0x09, 0x0a, 0x00, 0x21},
+    {0x00, 0x00, 0x00, 0x00, 0x22, 0x23, 0x24, 0x22, 0x23, 0x24, 0x22, 0x23, 0x24, 0x09, 0x0a, 0x09},
+    {0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x25, 0x09, 0x0a},
+    {0x00, 0x22, 0x23, 0x24, 0x09, 0x0a, 0x26, 0x27, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a},
+    {0x28, 0x00, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a},
+    {0x09, 0x0a, 0x09, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x09, 0x0a, 0x2a, 0x2b, 0x2c},
+    {0x2c, 0x09, 0x0a, 0x2d, 0x2e, 0x2f, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a},
+    {0x30, 0x31, 0x32, 0x33, 0x34, 0x00, 0x35, 0x35, 0x00, 0x36, 0x00, 0x37, 0x38, 0x00, 0x00, 0x00},
+    {0x35, 0x39, 0x00, 0x3a, 0x00, 0x3b, 0x3c, 0x00, 0x3d, 0x3e, 0x3c, 0x3f, 0x40, 0x00, 0x00, 0x3e},
+    {0x00, 0x41, 0x42, 0x00, 0x00, 0x43, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00},
+    {0x45, 0x00, 0x46, 0x45, 0x00, 0x00, 0x00, 0x47, 0x45, 0x48, 0x49, 0x49, 0x4a, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x4b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x4d, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x4e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x09, 0x0a, 0x09, 0x0a, 0x00, 0x00, 0x09, 0x0a, 0x00, 0x00, 0x00, 0x1c, 0x1c, 0x1c, 0x00, 0x4f},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x00, 0x51, 0x51, 0x51, 0x00, 0x52, 0x00, 0x53, 0x53},
+    {0x03, 0x03, 0x00, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x54, 0x55, 0x55, 0x55},
+    {0x06, 0x06, 0x56, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x57, 0x58, 0x58, 0x59},
+    {0x5a, 0x5b, 0x00, 0x00, 0x00, 0x5c, 0x5d, 0x5e, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a},
+    {0x5f, 0x60, 0x61, 0x62, 0x63, 0x64, 0x00, 0x09, 0x0a, 0x65, 0x09, 0x0a, 0x00, 0x28, 0x28, 0x28},
+    {0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66},
+    {0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67},
+    {0x09, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a},
+    {0x68, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x69},
+    {0x00, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a},
+    {0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a},
+    {0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x6a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b},
+    {0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b},
+    {0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x6b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x01, 0x02, 0x00, 0x00},
+    {0x6c, 0x6c, 0x6c, 0x6c, 0x6c, 0x6c, 0x6c, 0x6c, 0x6c, 0x6c, 0x6c, 0x6c, 0x6c, 0x6c, 0x6c, 0x6c},
+    {0x6c, 0x6c, 0x6c, 0x6c, 0x6c, 0x6c, 0x00, 0x6c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6c, 0x00, 0x00},
+    {0x6d, 0x6d, 0x6d, 0x6d, 0x6d, 0x6d, 0x6d, 0x6d, 0x6d, 0x6d, 0x6d, 0x6d, 0x6d, 0x6d, 0x6d, 0x6d},
+    {0x6d, 0x6d, 0x6d, 0x6d, 0x6d, 0x6d, 0x6d, 0x6d, 0x6d, 0x6d, 0x6d, 0x00, 0x00, 0x6d, 0x6d, 0x6d},
+    {0x6e, 0x6e, 0x6e, 0x6e, 0x6e, 0x6e, 0x6e, 0x6e, 0x6e, 0x6e, 0x6e, 0x6e, 0x6e, 0x6e, 0x6e, 0x6e},
+    {0x6f, 0x6f, 0x6f, 0x6f, 0x6f, 0x6f, 0x00, 0x00, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x00, 0x00, 0x00},
+    {0x71, 0x72, 0x73, 0x74, 0x74, 0x75, 0x76, 0x77, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x79, 0x79, 0x79, 0x79, 0x79, 0x79, 0x79, 0x79, 0x79, 0x79, 0x79, 0x79, 0x79, 0x79, 0x79, 0x79},
+    {0x79, 0x79, 0x79, 0x79, 0x79, 0x79, 0x79, 0x79, 0x79, 0x79, 0x79, 0x00, 0x00, 0x79, 0x79, 0x79},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7a, 0x00, 0x00, 0x00, 0x7b, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7c, 0x00},
+    {0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7d, 0x00, 0x00, 0x7e, 0x00},
+    {0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00},
+    {0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80},
+    {0x81, 0x81, 0x82, 0x82, 0x82, 0x82, 0x83, 0x83, 0x84, 0x84, 0x85, 0x85, 0x86, 0x86, 0x00, 0x00},
+    {0x7f, 0x7f, 0x00, 0x87, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x88, 0x88, 0x89, 0x00, 0x8a, 0x00},
+    {0x00, 0x00, 0x00, 0x87, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x8b, 0x8b, 0x8b, 0x89, 0x00, 0x00, 0x00},
+    {0x7f, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x8c, 0x8c, 0x00, 0x00, 0x00, 0x00},
+    {0x7f, 0x7f, 0x00, 0x00, 0x00, 0x61, 0x00, 0x00, 0x80, 0x80, 0x8d, 0x8d, 0x65, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x87, 0x00, 0x00, 0x00, 0x00, 0x8e, 0x8e, 0x8f, 0x8f, 0x89, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x90, 0x00, 0x00, 0x00, 0x91, 0x92, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x93, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x94, 0x00},
+    {0x95, 0x95, 0x95, 0x95, 0x95, 0x95, 0x95, 0x95, 0x95, 0x95, 0x95, 0x95, 0x95, 0x95, 0x95, 0x95},
+    {0x96, 0x96, 0x96, 0x96, 0x96, 0x96, 0x96, 0x96, 0x96, 0x96, 0x96, 0x96, 0x96, 0x96, 0x96, 0x96},
+    {0x00, 0x00, 0x00, 0x09, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x97, 0x97, 0x97, 0x97, 0x97, 0x97, 0x97, 0x97, 0x97, 0x97},
+    {0x97, 0x97, 0x97, 0x97, 0x97, 0x97, 0x97, 0x97, 0x97, 0x97, 0x97, 0x97, 0x97, 0x97, 0x97, 0x97},
+    {0x98, 0x98, 0x98, 0x98, 0x98, 0x98, 0x98, 0x98, 0x98, 0x98, 0x98, 0x98, 0x98, 0x98, 0x98, 0x98},
+    {0x98, 0x98, 0x98, 0x98, 0x98, 0x98, 0x98, 0x98, 0x98, 0x98, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02},
+    {0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02},
+    {0x00, 0x00, 0x00, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x99, 0x9a, 0x9b},
+    {0x9c, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x00, 0x00},
+    {0x09, 0x0a, 0x9d, 0x9e, 0x9f, 0xa0, 0xa1, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0xa2, 0xa3, 0xa4},
+    {0xa5, 0x00, 0x09, 0x0a, 0x00, 0x09, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa6, 0xa6},
+    {0x09, 0x0a, 0x09, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0x0a, 0x09, 0x0a, 0x00},
+    {0x00, 0x00, 0x09, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7},
+    {0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0xa7, 0x00, 0xa7, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa7, 0x00, 0x00},
+    {0x00, 0x00, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x00, 0x00, 0x00},
+    {0x01, 0x02, 0x00, 0x00, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00},
+    {0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x00, 0x00},
+    {0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0x0a, 0x09, 0x0a, 0xa8, 0x09, 0x0a},
+    {0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x00, 0x00, 0x00, 0x09, 0x0a, 0xa9, 0x00, 0x00},
+    {0x09, 0x0a, 0x09, 0x0a, 0xaa, 0x00, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a},
+    {0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0xab, 0xac, 0xad, 0xae, 0xab, 0x00},
+    {0xaf, 0xb0, 0xb1, 0xb2, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a, 0x09, 0x0a},
+    {0x09, 0x0a, 0x09, 0x0a, 0xb3, 0xb4, 0xb5, 0x09, 0x0a, 0x09, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x09, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x09, 0x0a, 0x09, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0xb6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xb7, 0xb7, 0xb7, 0xb7, 0xb7, 0xb7, 0xb7, 0xb7, 0xb7, 0xb7, 0xb7, 0xb7, 0xb7, 0xb7, 0xb7, 0xb7},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x00},
+    {0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x04, 0x00, 0x05, 0x00, 0x01},
+    {0x02, 0x00, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xb8, 0xb8, 0xb8, 0xb8, 0xb8, 0xb8, 0xb8, 0xb8, 0xb8, 0xb8, 0xb8, 0xb8, 0xb8, 0xb8, 0xb8, 0xb8},
+    {0xb8, 0xb8, 0xb8, 0xb8, 0xb8, 0xb8, 0xb8, 0xb8, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9},
+    {0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9},
+    {0xb8, 0xb8, 0xb8, 0xb8, 0x00, 0x00, 0x00, 0x00, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9},
+    {0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0xb9, 0x00, 0x00, 0x00, 0x00},
+    {0xba, 0xba, 0xba, 0xba, 0xba, 0xba, 0xba, 0xba, 0xba, 0xba, 0xba, 0x00, 0xba, 0xba, 0xba, 0xba},
+    {0xba, 0xba, 0xba, 0x00, 0xba, 0xba, 0x00, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb},
+    {0xbb, 0xbb, 0x00, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb},
+    {0xbb, 0xbb, 0x00, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0x00, 0xbb, 0xbb, 0x00, 0x00, 0x00},
+    {0x52, 0x52, 0x52, 0x52, 0x52, 0x52, 0x52, 0x52, 0x52, 0x52, 0x52, 0x52, 0x52, 0x52, 0x52, 0x52},
+    {0x52, 0x52, 0x52, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x57, 0x57, 0x57, 0x57, 0x57, 0x57, 0x57, 0x57, 0x57, 0x57, 0x57, 0x57, 0x57, 0x57, 0x57, 0x57},
+    {0x57, 0x57, 0x57, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xbc, 0xbc, 0xbc, 0xbc, 0xbc, 0xbc, 0xbc, 0xbc, 0xbc, 0xbc, 0xbc, 0xbc, 0xbc, 0xbc, 0xbc, 0xbc},
+    {0xbc, 0xbc, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd},
+    {0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd, 0xbd},
+    {0xbd, 0xbd, 0xbd, 0xbd, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+};
+
+static const unsigned short kDelta[190][5] = {
+    {0x0000, 0x0000, 0x0000, 0x0000, 0x0000}, {0x0000, 0x0000, 0x0000, 0x0001, 0x0000},
+    {0x0000, 0x0000, 0xffff, 0x0000, 0x0000}, {0x0020, 0x0000, 0x0000, 0x0000, 0x0020},
+    {0x0000, 0x0000, 0x0000, 0x0002, 0x0000}, {0x0000, 0x0000, 0xfffe, 0x0000, 0x0000},
+    {0x0000, 0xffe0, 0x0000, 0x0000, 0x0000}, {0x0000, 0x02e7, 0x0000, 0x0000, 0x0307},
+    {0x0000, 0x0079, 0x0000, 0x0000, 0x0000}, {0x0001, 0x0000, 0x0000, 0x0000, 0x0001},
+    {0x0000, 0xffff, 0x0000, 0x0000, 0x0000}, {0xff39, 0x0000, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0xff18, 0x0000, 0x0000, 0x0000}, {0xff87, 0x0000, 0x0000, 0x0000, 0xff87},
+    {0x0000, 0xfed4, 0x0000, 0x0000, 0xfef4}, {0x0000, 0x00c3, 0x0000, 0x0000, 0x0000},
+    {0x00d2, 0x0000, 0x0000, 0x0000, 0x00d2}, {0x00ce, 0x0000, 0x0000, 0x0000, 0x00ce},
+    {0x00cd, 0x0000, 0x0000, 0x0000, 0x00cd}, {0x004f, 0x0000, 0x0000, 0x0000, 0x004f},
+    {0x00ca, 0x0000, 0x0000, 0x0000, 0x00ca}, {0x00cb, 0x0000, 0x0000, 0x0000, 0x00cb},
+    {0x00cf, 0x0000, 0x0000, 0x0000, 0x00cf}, {0x0000, 0x0061, 0x0000, 0x0000, 0x0000},
+    {0x00d3, 0x0000, 0x0000, 0x0000, 0x00d3}, {0x00d1, 0x0000, 0x0000, 0x0000, 0x00d1},
+    {0x0000, 0x00a3, 0x0000, 0x0000, 0x0000}, {0x00d5, 0x0000, 0x0000, 0x0000, 0x00d5},
+    {0x0000, 0x0082, 0x0000, 0x0000, 0x0000}, {0x00d6, 0x0000, 0x0000, 0x0000, 0x00d6},
+    {0x00da, 0x0000, 0x0000, 0x0000, 0x00da}, {0x00d9, 0x0000, 0x0000, 0x0000, 0x00d9},
+    {0x00db, 0x0000, 0x0000, 0x0000, 0x00db}, {0x0000, 0x0038, 0x0000, 0x0000, 0x0000},
+    {0x0002, 0x0000, 0x0000, 0x0000, 0x0002}, {0x0001, 0xffff, 0x0000, 0x0000, 0x0001},
+    {0x0000, 0xfffe, 0x0000, 0x0000, 0x0000}, {0x0000, 0xffb1, 0x0000, 0x0000, 0x0000},
+    {0xff9f, 0x0000, 0x0000, 0x0000, 0xff9f}, {0xffc8, 0x0000, 0x0000, 0x0000, 0xffc8},
+    {0xff7e, 0x0000, 0x0000, 0x0000, 0xff7e}, {0x2a2b, 0x0000, 0x0000, 0x0000, 0x2a2b},
+    {0xff5d, 0x0000, 0x0000, 0x0000, 0xff5d}, {0x2a28, 0x0000, 0x0000, 0x0000, 0x2a28},
+    {0x0000, 0x2a3f, 0x0000, 0x0000, 0x0000}, {0xff3d, 0x0000, 0x0000, 0x0000, 0xff3d},
+    {0x0045, 0x0000, 0x0000, 0x0000, 0x0045}, {0x0047, 0x0000, 0x0000, 0x0000, 0x0047},
+    {0x0000, 0x2a1f, 0x0000, 0x0000, 0x0000}, {0x0000, 0x2a1c, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0x2a1e, 0x0000, 0x0000, 0x0000}, {0x0000, 0xff2e, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0xff32, 0x0000, 0x0000, 0x0000}, {0x0000, 0xff33, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0xff36, 0x0000, 0x0000, 0x0000}, {0x0000, 0xff35, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0xa54f, 0x0000, 0x0000, 0x0000}, {0x0000, 0xa54b, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0xff31, 0x0000, 0x0000, 0x0000}, {0x0000, 0xa528, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0xa544, 0x0000, 0x0000, 0x0000}, {0x0000, 0xff2f, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0xff2d, 0x0000, 0x0000, 0x0000}, {0x0000, 0x29f7, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0xa541, 0x0000, 0x0000, 0x0000}, {0x0000, 0x29fd, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0xff2b, 0x0000, 0x0000, 0x0000}, {0x0000, 0xff2a, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0x29e7, 0x0000, 0x0000, 0x0000}, {0x0000, 0xff26, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0xa543, 0x0000, 0x0000, 0x0000}, {0x0000, 0xa52a, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0xffbb, 0x0000, 0x0000, 0x0000}, {0x0000, 0xff27, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0xffb9, 0x0000, 0x0000, 0x0000}, {0x0000, 0xff25, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0xa515, 0x0000, 0x0000, 0x0000}, {0x0000, 0xa512, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0x0054, 0x0000, 0x0000, 0x0074}, {0x0074, 0x0000, 0x0000, 0x0000, 0x0074},
+    {0x0026, 0x0000, 0x0000, 0x0000, 0x0026}, {0x0025, 0x0000, 0x0000, 0x0000, 0x0025},
+    {0x0040, 0x0000, 0x0000, 0x0000, 0x0040}, {0x003f, 0x0000, 0x0000, 0x0000, 0x003f},
+    {0x0000, 0xffda, 0x0000, 0x0000, 0x0000}, {0x0000, 0xffdb, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0xffe1, 0x0000, 0x0000, 0x0001}, {0x0000, 0xffc0, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0xffc1, 0x0000, 0x0000, 0x0000}, {0x0008, 0x0000, 0x0000, 0x0000, 0x0008},
+    {0x0000, 0xffc2, 0x0000, 0x0000, 0xffe2}, {0x0000, 0xffc7, 0x0000, 0x0000, 0xffe7},
+    {0x0000, 0xffd1, 0x0000, 0x0000, 0xfff1}, {0x0000, 0xffca, 0x0000, 0x0000, 0xffea},
+    {0x0000, 0xfff8, 0x0000, 0x0000, 0x0000}, {0x0000, 0xffaa, 0x0000, 0x0000, 0xffca},
+    {0x0000, 0xffb0, 0x0000, 0x0000, 0xffd0}, {0x0000, 0x0007, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0xff8c, 0x0000, 0x0000, 0x0000}, {0xffc4, 0x0000, 0x0000, 0x0000, 0xffc4},
+    {0x0000, 0xffa0, 0x0000, 0x0000, 0xffc0}, {0xfff9, 0x0000, 0x0000, 0x0000, 0xfff9},
+    {0x0050, 0x0000, 0x0000, 0x0000, 0x0050}, {0x0000, 0xffb0, 0x0000, 0x0000, 0x0000},
+    {0x000f, 0x0000, 0x0000, 0x0000, 0x000f}, {0x0000, 0xfff1, 0x0000, 0x0000, 0x0000},
+    {0x0030, 0x0000, 0x0000, 0x0000, 0x0030}, {0x0000, 0xffd0, 0x0000, 0x0000, 0x0000},
+    {0x1c60, 0x0000, 0x0000, 0x0000, 0x1c60}, {0x0000, 0x0bc0, 0x0000, 0x0000, 0x0000},
+    {0x97d0, 0x0000, 0x0000, 0x0000, 0x0000}, {0x0008, 0x0000, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0xfff8, 0x0000, 0x0000, 0xfff8}, {0x0000, 0xe792, 0x0000, 0x0000, 0xe7b2},
+    {0x0000, 0xe793, 0x0000, 0x0000, 0xe7b3}, {0x0000, 0xe79c, 0x0000, 0x0000, 0xe7bc},
+    {0x0000, 0xe79e, 0x0000, 0x0000, 0xe7be}, {0x0000, 0xe79d, 0x0000, 0x0000, 0xe7bd},
+    {0x0000, 0xe7a4, 0x0000, 0x0000, 0xe7c4}, {0x0000, 0xe7db, 0x0000, 0x0000, 0xe7dc},
+    {0x0000, 0x89c2, 0x0000, 0x0000, 0x89c3}, {0xf440, 0x0000, 0x0000, 0x0000, 0xf440},
+    {0x0000, 0x8a04, 0x0000, 0x0000, 0x0000}, {0x0000, 0x0ee6, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0x8a38, 0x0000, 0x0000, 0x0000}, {0x0000, 0xffc5, 0x0000, 0x0000, 0xffc6},
+    {0xe241, 0x0000, 0x0000, 0x0000, 0xe241}, {0x0000, 0x0008, 0x0000, 0x0000, 0x0000},
+    {0xfff8, 0x0000, 0x0000, 0x0000, 0xfff8}, {0x0000, 0x004a, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0x0056, 0x0000, 0x0000, 0x0000}, {0x0000, 0x0064, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0x0080, 0x0000, 0x0000, 0x0000}, {0x0000, 0x0070, 0x0000, 0x0000, 0x0000},
+    {0x0000, 0x007e, 0x0000, 0x0000, 0x0000}, {0x0000, 0x0009, 0x0000, 0x0000, 0x0000},
+    {0xffb6, 0x0000, 0x0000, 0x0000, 0xffb6}, {0xfff7, 0x0000, 0x0000, 0x0000, 0xfff7},
+    {0x0000, 0xe3db, 0x0000, 0x0000, 0xe3fb}, {0xffaa, 0x0000, 0x0000, 0x0000, 0xffaa},
+    {0xff9c, 0x0000, 0x0000, 0x0000, 0xff9c}, {0xff90, 0x0000, 0x0000, 0x0000, 0xff90},
+    {0xff80, 0x0000, 0x0000, 0x0000, 0xff80}, {0xff82, 0x0000, 0x0000, 0x0000, 0xff82},
+    {0xe2a3, 0x0000, 0x0000, 0x0000, 0xe2a3}, {0xdf41, 0x0000, 0x0000, 0x0000, 0xdf41},
+    {0xdfba, 0x0000, 0x0000, 0x0000, 0xdfba}, {0x001c, 0x0000, 0x0000, 0x0000, 0x001c},
+    {0x0000, 0xffe4, 0x0000, 0x0000, 0x0000}, {0x0010, 0x0000, 0x0000, 0x0000, 0x0010},
+    {0x0000, 0xfff0, 0x0000, 0x0000, 0x0000}, {0x001a, 0x0000, 0x0000, 0x0000, 0x001a},
+    {0x0000, 0xffe6, 0x0000, 0x0000, 0x0000}, {0x0000, 0x0000, 0x0000, 0x0003, 0x0000},
+    {0x0000, 0x0000, 0x0001, 0x0000, 0x0000}, {0x0000, 0x0000, 0x0000, 0xffff, 0x0000},
+    {0x0000, 0x0000, 0xfffd, 0x0000, 0x0000}, {0xd609, 0x0000, 0x0000, 0x0000, 0xd609},
+    {0xf11a, 0x0000, 0x0000, 0x0000, 0xf11a}, {0xd619, 0x0000, 0x0000, 0x0000, 0xd619},
+    {0x0000, 0xd5d5, 0x0000, 0x0000, 0x0000}, {0x0000, 0xd5d8, 0x0000, 0x0000, 0x0000},
+    {0xd5e4, 0x0000, 0x0000, 0x0000, 0xd5e4}, {0xd603, 0x0000, 0x0000, 0x0000, 0xd603},
+    {0xd5e1, 0x0000, 0x0000, 0x0000, 0xd5e1}, {0xd5e2, 0x0000, 0x0000, 0x0000, 0xd5e2},
+    {0xd5c1, 0x0000, 0x0000, 0x0000, 0xd5c1}, {0x0000, 0xe3a0, 0x0000, 0x0000, 0x0000},
+    {0x75fc, 0x0000, 0x0000, 0x0000, 0x75fc}, {0x5ad8, 0x0000, 0x0000, 0x0000, 0x5ad8},
+    {0x0000, 0x0030, 0x0000, 0x0000, 0x0000}, {0x5abc, 0x0000, 0x0000, 0x0000, 0x5abc},
+    {0x5ab1, 0x0000, 0x0000, 0x0000, 0x5ab1}, {0x5ab5, 0x0000, 0x0000, 0x0000, 0x5ab5},
+    {0x5abf, 0x0000, 0x0000, 0x0000, 0x5abf}, {0x5aee, 0x0000, 0x0000, 0x0000, 0x5aee},
+    {0x5ad6, 0x0000, 0x0000, 0x0000, 0x5ad6}, {0x5aeb, 0x0000, 0x0000, 0x0000, 0x5aeb},
+    {0x03a0, 0x0000, 0x0000, 0x0000, 0x03a0}, {0xffd0, 0x0000, 0x0000, 0x0000, 0xffd0},
+    {0x5abd, 0x0000, 0x0000, 0x0000, 0x5abd}, {0x75c8, 0x0000, 0x0000, 0x0000, 0x75c8},
+    {0x0000, 0xfc60, 0x0000, 0x0000, 0x0000}, {0x0000, 0x6830, 0x0000, 0x0000, 0x6830},
+    {0x0028, 0x0000, 0x0000, 0x0000, 0x0028}, {0x0000, 0xffd8, 0x0000, 0x0000, 0x0000},
+    {0x0027, 0x0000, 0x0000, 0x0000, 0x0027}, {0x0000, 0xffd9, 0x0000, 0x0000, 0x0000},
+    {0x0022, 0x0000, 0x0000, 0x0000, 0x0022}, {0x0000, 0xffde, 0x0000, 0x0000, 0x0000},
+};
+
+enum {
+    kGraphemeOther,
+    kGraphemeCR,
+    kGraphemeLF,
+    kGraphemeControl,
+    kGraphemeExtend,
+    kGraphemeZWJ,
+    kGraphemeRegionalIndicator,
+    kGraphemePrepend,
+    kGraphemeSpacingMark,
+    kGraphemeL,
+    kGraphemeV,
+    kGraphemeT,
+    kGraphemeLV,
+    kGraphemeLVT,
+    kGraphemePictographic,
+};
+
+static const unsigned char kGraphemeStage1[0x110] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x05, 0x06, 0x07, 0x08, 0x04, 0x09,
+    0x0a, 0x0b, 0x04, 0x0c, 0x04, 0x04, 0x0d, 0x04, 0x04, 0x04, 0x04, 0x0e, 0x0f, 0x10, 0x11, 0x12,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x13, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+};
+
+static const unsigned char kGraphemeStage2[20][64] = {
+    {0x00, 0x01, 0x02, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x04, 0x05, 0x03, 0x03,
+     0x03, 0x03, 0x06, 0x03, 0x03, 0x03, 0x07, 0x08, 0x09, 0x0a, 0x03, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+     0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x18, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e,
+     0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e},
+    {0x2f, 0x30, 0x31, 0x03, 0x32, 0x33, 0x34, 0x35, 0x03, 0x03, 0x03, 0x03, 0x03, 0x36, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x37, 0x38, 0x39, 0x3a,
+     0x3b, 0x03, 0x3c, 0x03, 0x3d, 0x03, 0x03, 0x03, 0x3e, 0x3f, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45,
+     0x46, 0x03, 0x03, 0x47, 0x03, 0x03, 0x03, 0x04, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03},
+    {0x48, 0x49, 0x03, 0x4a, 0x4b, 0x03, 0x4c, 0x03, 0x03, 0x03, 0x03, 0x03, 0x4d, 0x03, 0x4e, 0x4f,
+     0x03, 0x03, 0x03, 0x50, 0x03, 0x03, 0x51, 0x52, 0x53, 0x54, 0x55, 0x54, 0x56, 0x57, 0x58, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x59, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x5a, 0x5b, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x5c, 0x03, 0x5d, 0x03, 0x5e, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03},
+    {0x5f, 0x03, 0x60, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x61, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03},
+    {0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03},
+    {0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x62, 0x63, 0x64, 0x03, 0x03, 0x03, 0x03,
+     0x65, 0x03, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f, 0x03, 0x03, 0x03, 0x70,
+     0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x71, 0x72},
+    {0x73, 0x74, 0x75, 0x76, 0x77, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x71, 0x72, 0x73, 0x74,
+     0x75, 0x76, 0x77, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76,
+     0x77, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x71,
+     0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x71, 0x72, 0x73},
+    {0x74, 0x75, 0x76, 0x77, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x71, 0x72, 0x73, 0x74, 0x75,
+     0x76, 0x77, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77,
+     0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x71, 0x72,
+     0x73, 0x74, 0x75, 0x76, 0x77, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x71, 0x72, 0x73, 0x74},
+    {0x75, 0x76, 0x77, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76,
+     0x77, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x78, 0x79,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03},
+    {0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x7a, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x7b, 0x03, 0x03, 0x01, 0x03, 0x03, 0x63, 0x7c},
+    {0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x7d, 0x03, 0x03, 0x03, 0x7e, 0x03, 0x7f, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x80, 0x03, 0x03, 0x81, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x82, 0x03, 0x03, 0x03, 0x03, 0x03, 0x83, 0x03, 0x03, 0x84, 0x85, 0x03},
+    {0x86, 0x87, 0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x03, 0x03, 0x8f, 0x23, 0x90, 0x03, 0x03,
+     0x91, 0x92, 0x93, 0x94, 0x03, 0x03, 0x95, 0x96, 0x97, 0x98, 0x99, 0x03, 0x9a, 0x03, 0x03, 0x03,
+     0x9b, 0x03, 0x03, 0x03, 0x9c, 0x9d, 0x03, 0x9e, 0x9f, 0xa0, 0xa1, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0xa2, 0x03, 0xa3, 0x03, 0xa4, 0xa5, 0xa6, 0x03, 0x03, 0x03, 0x03, 0xa7, 0x03, 0x03, 0x03, 0x03},
+    {0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0xa8, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03},
+    {0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xa9, 0xaa, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xab, 0xac, 0xad},
+    {0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0xae, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03},
+    {0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xaf, 0xb0, 0x03, 0x03},
+    {0x03, 0x03, 0x03, 0x03, 0x03, 0xb1, 0xb2, 0x03, 0x03, 0xb3, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xb4, 0xb5, 0xb6, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03},
+    {0xb7, 0x03, 0x03, 0x03, 0xaa, 0x03, 0x03, 0x03, 0x03, 0x03, 0xb8, 0xb9, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0xba, 0x03, 0xbb, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03},
+    {0x54, 0x54, 0x54, 0x54, 0xbc, 0xbd, 0xbe, 0xbf, 0xc0, 0xc1, 0x54, 0x54, 0x54, 0x54, 0x54, 0xc2,
+     0x54, 0x54, 0x54, 0x54, 0xc3, 0xc4, 0x54, 0x54, 0x54, 0xc5, 0x54, 0x54, 0x03, 0xc6, 0x03, 0xc7,
+     0xc8, 0xc9, 0xca, 0x54, 0xcb, 0xcc, 0x54, 0x54, 0x54, 0x54, 0x54, 0x54, 0x03, 0x03, 0x03, 0x03,
+     0x54, 0x54, 0x54, 0x54, 0x54, 0x54, 0x54, 0x54, 0x54, 0x54, 0x54, 0x54, 0x54, 0x54, 0x54, 0xc3},
+    {0xcd, 0x04, 0xce, 0xce, 0x04, 0x04, 0x04, 0xcf, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce,
+     0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce,
+     0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce,
+     0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xce},
+};
+
+static const unsigned char kGraphemeStage3[208][32] = {
+    {0x33, 0x33, 0x33, 0x33, 0x33, 0x32, 0x13, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30},
+    {0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+     0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x30, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+     0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44},
+    {0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+     0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x40, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+     0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x40},
+    {0x40, 0x04, 0x44, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x77, 0x77, 0x77, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x44, 0x44, 0x04, 0x03, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x74, 0x40,
+     0x44, 0x44, 0x04, 0x40, 0x04, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44},
+    {0x44, 0x44, 0x44, 0x44, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x44, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x44, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x40, 0x44, 0x44,
+     0x44, 0x44, 0x40, 0x44, 0x40, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x44, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x77, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x44,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+     0x44, 0x47, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44},
+    {0x44, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x84, 0x04, 0x88},
+    {0x48, 0x44, 0x44, 0x44, 0x84, 0x88, 0x48, 0x88, 0x40, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x40, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x84},
+    {0x48, 0x44, 0x04, 0x80, 0x08, 0x80, 0x48, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04},
+    {0x40, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x88},
+    {0x48, 0x04, 0x00, 0x40, 0x04, 0x40, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x48, 0x44, 0x44, 0x40, 0x84, 0x80, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44},
+    {0x40, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x44},
+    {0x48, 0x44, 0x04, 0x80, 0x08, 0x80, 0x48, 0x00, 0x00, 0x00, 0x40, 0x44, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x84},
+    {0x84, 0x08, 0x00, 0x88, 0x08, 0x88, 0x48, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x84, 0x88, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x44},
+    {0x84, 0x88, 0x08, 0x44, 0x04, 0x44, 0x44, 0x00, 0x00, 0x00, 0x40, 0x04, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x40, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x48},
+    {0x88, 0x84, 0x08, 0x84, 0x08, 0x88, 0x44, 0x00, 0x00, 0x00, 0x40, 0x04, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x44, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x04, 0x84},
+    {0x48, 0x44, 0x04, 0x88, 0x08, 0x88, 0x48, 0x07, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x40, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x40, 0x88, 0x44, 0x04, 0x04, 0x88, 0x88, 0x88, 0x48,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x80, 0x44, 0x44, 0x44, 0x04, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x40, 0x44, 0x44, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x80, 0x44, 0x44, 0x44, 0x44, 0x04, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x40, 0x40, 0x00, 0x00, 0x88},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x84},
+    {0x44, 0x44, 0x04, 0x44, 0x00, 0x00, 0x40, 0x44, 0x44, 0x44, 0x44, 0x44, 0x40, 0x44, 0x44, 0x44,
+     0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x04, 0x00},
+    {0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x44, 0x84, 0x44, 0x44, 0x44, 0x40, 0x84, 0x48, 0x04},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x88, 0x44, 0x00, 0x00, 0x44,
+     0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x04, 0x48, 0x04, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99,
+     0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99},
+    {0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99,
+     0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa},
+    {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+     0xaa, 0xaa, 0xaa, 0xaa, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb},
+    {0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb,
+     0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x44,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x48, 0x44, 0x44, 0x44, 0x88},
+    {0x88, 0x88, 0x88, 0x84, 0x48, 0x44, 0x44, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x44, 0x43, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x40, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x44, 0x84, 0x88, 0x48, 0x84, 0x88, 0x00, 0x00, 0x88, 0x84, 0x88, 0x88, 0x48, 0x44, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x84, 0x48, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x84, 0x44, 0x44, 0x44, 0x04,
+     0x04, 0x04, 0x40, 0x44, 0x44, 0x44, 0x84, 0x88, 0x88, 0x48, 0x44, 0x44, 0x44, 0x44, 0x04, 0x40},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44},
+    {0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x44, 0x44, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x84, 0x84, 0x88},
+    {0x88, 0x84, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x44, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x44, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x80, 0x44, 0x44, 0x88, 0x44, 0x48, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x84, 0x44, 0x88, 0x48, 0x48, 0x44, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x88, 0x88, 0x88, 0x88, 0x44, 0x44, 0x44, 0x44, 0x88, 0x44, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x04, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+     0x84, 0x44, 0x44, 0x44, 0x04, 0x00, 0x40, 0x00, 0x00, 0x00, 0x04, 0x80, 0x44, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x54, 0x33, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+     0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xee, 0xee, 0xee, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0xe0, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xee, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0xe0, 0xee, 0xee, 0xee, 0xee, 0xee, 0x00, 0x00, 0xee, 0x0e, 0x00, 0x00},
+    {0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0xee, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00},
+    {0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xee, 0x0e},
+    {0xee, 0xee, 0xee, 0xe0, 0xee, 0xee, 0xee, 0xee, 0xee, 0x0e, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee,
+     0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee},
+    {0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee,
+     0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee},
+    {0xee, 0xee, 0xee, 0x00, 0x00, 0x00, 0x00, 0x00, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee,
+     0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee},
+    {0xee, 0xee, 0xee, 0x00, 0xee, 0xee, 0xee, 0xee, 0xee, 0x0e, 0x0e, 0x0e, 0x00, 0x00, 0xe0, 0x00,
+     0xe0, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x0e, 0xe0, 0x00, 0x00, 0x0e, 0x0e, 0x00, 0xe0, 0xee, 0xe0, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0xe0, 0xee, 0xee, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xee, 0x00, 0x00, 0x00, 0x00,
+     0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xee, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0xe0, 0xee, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x0e, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x04, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xe0, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x44, 0x04, 0x44, 0x44, 0x44, 0x44, 0x44, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x04, 0x00, 0x04, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x80, 0x48, 0x84, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88},
+    {0x88, 0x88, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x40, 0x44, 0x44, 0x44, 0x44, 0x44, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x09, 0x00},
+    {0x44, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x88, 0x44, 0x44, 0x88, 0x44, 0x88},
+    {0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x40, 0x44, 0x44, 0x84, 0x48, 0x84, 0x48, 0x04, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x44, 0x04, 0x40, 0x04, 0x00, 0x00, 0x44},
+    {0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x44, 0x88, 0x00, 0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x80, 0x48, 0x88, 0x84, 0x08, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xdc, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdc, 0xdd,
+     0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdc, 0xdd, 0xdd, 0xdd},
+    {0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdc, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+     0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdc, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd},
+    {0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdc, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+     0xdd, 0xdd, 0xdd, 0xdd, 0xdc, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd},
+    {0xdd, 0xdd, 0xdc, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+     0xdc, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdc, 0xdd},
+    {0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdc, 0xdd, 0xdd, 0xdd,
+     0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdc, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd},
+    {0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdc, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+     0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdc, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd},
+    {0xdd, 0xdd, 0xdd, 0xdd, 0xdc, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+     0xdd, 0xdd, 0xdc, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd},
+    {0xdd, 0xdd, 0xdd, 0xdd, 0xdc, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+     0xdd, 0xdd, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa},
+    {0xaa, 0xaa, 0xaa, 0x0a, 0x00, 0xb0, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb,
+     0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x04, 0x00, 0x00},
+    {0x40, 0x44, 0x40, 0x04, 0x00, 0x00, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x04, 0x00, 0x40},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x40, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x44, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x48, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x44},
+    {0x44, 0x44, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x40, 0x04, 0x00, 0x00, 0x00, 0x00, 0x40},
+    {0x44, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x88, 0x48, 0x44, 0x84, 0x48, 0x04, 0x70, 0x00},
+    {0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x44, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x40, 0x44, 0x44, 0x48, 0x44, 0x44, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x44, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x88, 0x44, 0x44, 0x44, 0x44, 0x84},
+    {0x08, 0x77, 0x00, 0x00, 0x40, 0x44, 0x04, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x88, 0x48, 0x44, 0x88, 0x84, 0x44, 0x00, 0x00, 0x00, 0x04},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40,
+     0x88, 0x48, 0x44, 0x44, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x84, 0x88, 0x08, 0x80, 0x08, 0x80, 0x88, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x88, 0x00, 0x44, 0x44, 0x44, 0x04, 0x00, 0x44, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x88, 0x44, 0x44, 0x44, 0x44},
+    {0x88, 0x44, 0x84, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x84, 0x48, 0x44, 0x44, 0x84, 0x84, 0x48, 0x48},
+    {0x84, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x88, 0x44, 0x44, 0x00, 0x88, 0x88, 0x44, 0x48},
+    {0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x88, 0x48, 0x44, 0x44, 0x44, 0x84, 0x48, 0x48},
+    {0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x48, 0x88, 0x44, 0x44, 0x44, 0x48, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x44,
+     0x00, 0x44, 0x44, 0x48, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x88, 0x48, 0x44, 0x44, 0x44, 0x44, 0x48, 0x04, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x84, 0x88, 0x88, 0x80, 0x08, 0x40, 0x84, 0x74},
+    {0x78, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x88, 0x44, 0x44, 0x00, 0x44, 0x88, 0x88,
+     0x04, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x40, 0x44, 0x44, 0x44, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x44, 0x44, 0x84, 0x47, 0x44, 0x04},
+    {0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x40, 0x44, 0x44, 0x84, 0x48, 0x44, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x77, 0x77, 0x77, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x84, 0x44, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x44, 0x44, 0x44, 0x04, 0x44, 0x44, 0x44, 0x48},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+     0x44, 0x44, 0x44, 0x44, 0x80, 0x44, 0x44, 0x44, 0x84, 0x44, 0x48, 0x04, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x44, 0x44, 0x04, 0x00, 0x04, 0x44, 0x40},
+    {0x44, 0x44, 0x44, 0x47, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x88, 0x88, 0x08, 0x44, 0x80, 0x48, 0x48, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x84, 0x08, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x03, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x80, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88,
+     0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88},
+    {0x88, 0x88, 0x88, 0x88, 0x00, 0x00, 0x00, 0x40, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x04,
+     0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+     0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x00, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44},
+    {0x44, 0x44, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x40, 0x48, 0x44, 0x00, 0x80, 0x44, 0x44, 0x34, 0x33, 0x33, 0x33, 0x43, 0x44, 0x44},
+    {0x44, 0x04, 0x40, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+     0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x04, 0x00, 0x40, 0x44, 0x44},
+    {0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+     0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x04, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x44, 0x44,
+     0x40, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x44, 0x44, 0x44, 0x04, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x04, 0x40, 0x44, 0x44,
+     0x44, 0x40, 0x04, 0x44, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x44, 0x44, 0x44, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xee, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xee, 0xee, 0xee, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xee},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0xe0, 0xee, 0xee, 0xee, 0xee, 0x0e, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee},
+    {0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee,
+     0xee, 0xee, 0xee, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66},
+    {0xe0, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0xee, 0xee, 0xee, 0xee, 0x0e, 0xee, 0xee},
+    {0x00, 0x00, 0x00, 0x00, 0xe0, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee,
+     0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee},
+    {0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee,
+     0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0x4e, 0x44, 0x44},
+    {0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee,
+     0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0x00},
+    {0x00, 0x00, 0x00, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee,
+     0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee},
+    {0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0xee, 0xee, 0xee, 0xee, 0xee,
+     0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xee, 0xee, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0xee, 0xee, 0xee, 0xee, 0x00, 0x00, 0x00, 0x00, 0x00, 0xee, 0xee, 0xee,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00, 0x00, 0xee, 0xee, 0xee, 0xee, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee,
+     0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0x0e, 0xee, 0xee},
+    {0xee, 0xee, 0xee, 0xe0, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee,
+     0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee},
+    {0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+     0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44},
+    {0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+     0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33},
+    {0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
+     0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33},
+};
+/* END GENERATED UNICODE TABLES */
+
 /**
  * Returns monospace character width.
  *
@@ -282,252 +1936,11 @@ static char IsControl(unsigned c) {
  * that this won't return -1 for various character ranges.
  */
 int bestlineCharacterWidth(int c) {
-    if ((0x000 <= c && c <= 0x01F) || (0x07F <= c && c <= 0x09F) ||
-        (0x300 <= c && c <= 0x36f) || (0x483 <= c && c <= 0x489) ||
-        (0x591 <= c && c <= 0x5bd) || (0x5bf <= c && c <= 0x5bf) ||
-        (0x5c1 <= c && c <= 0x5c2) || (0x5c4 <= c && c <= 0x5c5) ||
-        (0x5c7 <= c && c <= 0x5c7) || (0x610 <= c && c <= 0x61a) ||
-        (0x61c <= c && c <= 0x61c) || (0x64b <= c && c <= 0x65f) ||
-        (0x670 <= c && c <= 0x670) || (0x6d6 <= c && c <= 0x6dc) ||
-        (0x6df <= c && c <= 0x6e4) || (0x6e7 <= c && c <= 0x6e8) ||
-        (0x6ea <= c && c <= 0x6ed) || (0x711 <= c && c <= 0x711) ||
-        (0x730 <= c && c <= 0x74a) || (0x7a6 <= c && c <= 0x7b0) ||
-        (0x7eb <= c && c <= 0x7f3) || (0x7fd <= c && c <= 0x7fd) ||
-        (0x816 <= c && c <= 0x819) || (0x81b <= c && c <= 0x823) ||
-        (0x825 <= c && c <= 0x827) || (0x829 <= c && c <= 0x82d) ||
-        (0x859 <= c && c <= 0x85b) || (0x898 <= c && c <= 0x89f) ||
-        (0x8ca <= c && c <= 0x8e1) || (0x8e3 <= c && c <= 0x902) ||
-        (0x93a <= c && c <= 0x93a) || (0x93c <= c && c <= 0x93c) ||
-        (0x941 <= c && c <= 0x948) || (0x94d <= c && c <= 0x94d) ||
-        (0x951 <= c && c <= 0x957) || (0x962 <= c && c <= 0x963) ||
-        (0x981 <= c && c <= 0x981) || (0x9bc <= c && c <= 0x9bc) ||
-        (0x9c1 <= c && c <= 0x9c4) || (0x9cd <= c && c <= 0x9cd) ||
-        (0x9e2 <= c && c <= 0x9e3) || (0x9fe <= c && c <= 0x9fe) ||
-        (0xa01 <= c && c <= 0xa02) || (0xa3c <= c && c <= 0xa3c) ||
-        (0xa41 <= c && c <= 0xa42) || (0xa47 <= c && c <= 0xa48) ||
-        (0xa4b <= c && c <= 0xa4d) || (0xa51 <= c && c <= 0xa51) ||
-        (0xa70 <= c && c <= 0xa71) || (0xa75 <= c && c <= 0xa75) ||
-        (0xa81 <= c && c <= 0xa82) || (0xabc <= c && c <= 0xabc) ||
-        (0xac1 <= c && c <= 0xac5) || (0xac7 <= c && c <= 0xac8) ||
-        (0xacd <= c && c <= 0xacd) || (0xae2 <= c && c <= 0xae3) ||
-        (0xafa <= c && c <= 0xaff) || (0xb01 <= c && c <= 0xb01) ||
-        (0xb3c <= c && c <= 0xb3c) || (0xb3f <= c && c <= 0xb3f) ||
-        (0xb41 <= c && c <= 0xb44) || (0xb4d <= c && c <= 0xb4d) ||
-        (0xb55 <= c && c <= 0xb56) || (0xb62 <= c && c <= 0xb63) ||
-        (0xb82 <= c && c <= 0xb82) || (0xbc0 <= c && c <= 0xbc0) ||
-        (0xbcd <= c && c <= 0xbcd) || (0xc00 <= c && c <= 0xc00) ||
-        (0xc04 <= c && c <= 0xc04) || (0xc3c <= c && c <= 0xc3c) ||
-        (0xc3e <= c && c <= 0xc40) || (0xc46 <= c && c <= 0xc48) ||
-        (0xc4a <= c && c <= 0xc4d) || (0xc55 <= c && c <= 0xc56) ||
-        (0xc62 <= c && c <= 0xc63) || (0xc81 <= c && c <= 0xc81) ||
-        (0xcbc <= c && c <= 0xcbc) || (0xcbf <= c && c <= 0xcbf) ||
-        (0xcc6 <= c && c <= 0xcc6) || (0xccc <= c && c <= 0xccd) ||
-        (0xce2 <= c && c <= 0xce3) || (0xd00 <= c && c <= 0xd01) ||
-        (0xd3b <= c && c <= 0xd3c) || (0xd41 <= c && c <= 0xd44) ||
-        (0xd4d <= c && c <= 0xd4d) || (0xd62 <= c && c <= 0xd63) ||
-        (0xd81 <= c && c <= 0xd81) || (0xdca <= c && c <= 0xdca) ||
-        (0xdd2 <= c && c <= 0xdd4) || (0xdd6 <= c && c <= 0xdd6) ||
-        (0xe31 <= c && c <= 0xe31) || (0xe34 <= c && c <= 0xe3a) ||
-        (0xe47 <= c && c <= 0xe4e) || (0xeb1 <= c && c <= 0xeb1) ||
-        (0xeb4 <= c && c <= 0xebc) || (0xec8 <= c && c <= 0xece) ||
-        (0xf18 <= c && c <= 0xf19) || (0xf35 <= c && c <= 0xf35) ||
-        (0xf37 <= c && c <= 0xf37) || (0xf39 <= c && c <= 0xf39) ||
-        (0xf71 <= c && c <= 0xf7e) || (0xf80 <= c && c <= 0xf84) ||
-        (0xf86 <= c && c <= 0xf87) || (0xf8d <= c && c <= 0xf97) ||
-        (0xf99 <= c && c <= 0xfbc) || (0xfc6 <= c && c <= 0xfc6) ||
-        (0x102d <= c && c <= 0x1030) || (0x1032 <= c && c <= 0x1037) ||
-        (0x1039 <= c && c <= 0x103a) || (0x103d <= c && c <= 0x103e) ||
-        (0x1058 <= c && c <= 0x1059) || (0x105e <= c && c <= 0x1060) ||
-        (0x1071 <= c && c <= 0x1074) || (0x1082 <= c && c <= 0x1082) ||
-        (0x1085 <= c && c <= 0x1086) || (0x108d <= c && c <= 0x108d) ||
-        (0x109d <= c && c <= 0x109d) || (0x1160 <= c && c <= 0x11ff) ||
-        (0x135d <= c && c <= 0x135f) || (0x1712 <= c && c <= 0x1714) ||
-        (0x1732 <= c && c <= 0x1733) || (0x1752 <= c && c <= 0x1753) ||
-        (0x1772 <= c && c <= 0x1773) || (0x17b4 <= c && c <= 0x17b5) ||
-        (0x17b7 <= c && c <= 0x17bd) || (0x17c6 <= c && c <= 0x17c6) ||
-        (0x17c9 <= c && c <= 0x17d3) || (0x17dd <= c && c <= 0x17dd) ||
-        (0x180b <= c && c <= 0x180f) || (0x1885 <= c && c <= 0x1886) ||
-        (0x18a9 <= c && c <= 0x18a9) || (0x1920 <= c && c <= 0x1922) ||
-        (0x1927 <= c && c <= 0x1928) || (0x1932 <= c && c <= 0x1932) ||
-        (0x1939 <= c && c <= 0x193b) || (0x1a17 <= c && c <= 0x1a18) ||
-        (0x1a1b <= c && c <= 0x1a1b) || (0x1a56 <= c && c <= 0x1a56) ||
-        (0x1a58 <= c && c <= 0x1a5e) || (0x1a60 <= c && c <= 0x1a60) ||
-        (0x1a62 <= c && c <= 0x1a62) || (0x1a65 <= c && c <= 0x1a6c) ||
-        (0x1a73 <= c && c <= 0x1a7c) || (0x1a7f <= c && c <= 0x1a7f) ||
-        (0x1ab0 <= c && c <= 0x1ace) || (0x1b00 <= c && c <= 0x1b03) ||
-        (0x1b34 <= c && c <= 0x1b34) || (0x1b36 <= c && c <= 0x1b3a) ||
-        (0x1b3c <= c && c <= 0x1b3c) || (0x1b42 <= c && c <= 0x1b42) ||
-        (0x1b6b <= c && c <= 0x1b73) || (0x1b80 <= c && c <= 0x1b81) ||
-        (0x1ba2 <= c && c <= 0x1ba5) || (0x1ba8 <= c && c <= 0x1ba9) ||
-        (0x1bab <= c && c <= 0x1bad) || (0x1be6 <= c && c <= 0x1be6) ||
-        (0x1be8 <= c && c <= 0x1be9) || (0x1bed <= c && c <= 0x1bed) ||
-        (0x1bef <= c && c <= 0x1bf1) || (0x1c2c <= c && c <= 0x1c33) ||
-        (0x1c36 <= c && c <= 0x1c37) || (0x1cd0 <= c && c <= 0x1cd2) ||
-        (0x1cd4 <= c && c <= 0x1ce0) || (0x1ce2 <= c && c <= 0x1ce8) ||
-        (0x1ced <= c && c <= 0x1ced) || (0x1cf4 <= c && c <= 0x1cf4) ||
-        (0x1cf8 <= c && c <= 0x1cf9) || (0x1dc0 <= c && c <= 0x1dff) ||
-        (0x200b <= c && c <= 0x200f) || (0x202a <= c && c <= 0x202e) ||
-        (0x2060 <= c && c <= 0x2064) || (0x2066 <= c && c <= 0x206f) ||
-        (0x20d0 <= c && c <= 0x20f0) || (0x2cef <= c && c <= 0x2cf1) ||
-        (0x2d7f <= c && c <= 0x2d7f) || (0x2de0 <= c && c <= 0x2dff) ||
-        (0x302a <= c && c <= 0x302d) || (0x3099 <= c && c <= 0x309a) ||
-        (0xa66f <= c && c <= 0xa672) || (0xa674 <= c && c <= 0xa67d) ||
-        (0xa69e <= c && c <= 0xa69f) || (0xa6f0 <= c && c <= 0xa6f1) ||
-        (0xa802 <= c && c <= 0xa802) || (0xa806 <= c && c <= 0xa806) ||
-        (0xa80b <= c && c <= 0xa80b) || (0xa825 <= c && c <= 0xa826) ||
-        (0xa82c <= c && c <= 0xa82c) || (0xa8c4 <= c && c <= 0xa8c5) ||
-        (0xa8e0 <= c && c <= 0xa8f1) || (0xa8ff <= c && c <= 0xa8ff) ||
-        (0xa926 <= c && c <= 0xa92d) || (0xa947 <= c && c <= 0xa951) ||
-        (0xa980 <= c && c <= 0xa982) || (0xa9b3 <= c && c <= 0xa9b3) ||
-        (0xa9b6 <= c && c <= 0xa9b9) || (0xa9bc <= c && c <= 0xa9bd) ||
-        (0xa9e5 <= c && c <= 0xa9e5) || (0xaa29 <= c && c <= 0xaa2e) ||
-        (0xaa31 <= c && c <= 0xaa32) || (0xaa35 <= c && c <= 0xaa36) ||
-        (0xaa43 <= c && c <= 0xaa43) || (0xaa4c <= c && c <= 0xaa4c) ||
-        (0xaa7c <= c && c <= 0xaa7c) || (0xaab0 <= c && c <= 0xaab0) ||
-        (0xaab2 <= c && c <= 0xaab4) || (0xaab7 <= c && c <= 0xaab8) ||
-        (0xaabe <= c && c <= 0xaabf) || (0xaac1 <= c && c <= 0xaac1) ||
-        (0xaaec <= c && c <= 0xaaed) || (0xaaf6 <= c && c <= 0xaaf6) ||
-        (0xabe5 <= c && c <= 0xabe5) || (0xabe8 <= c && c <= 0xabe8) ||
-        (0xabed <= c && c <= 0xabed) || (0xd7b0 <= c && c <= 0xd7c6) ||
-        (0xd7cb <= c && c <= 0xd7fb) || (0xfb1e <= c && c <= 0xfb1e) ||
-        (0xfe00 <= c && c <= 0xfe0f) || (0xfe20 <= c && c <= 0xfe2f) ||
-        (0xfeff <= c && c <= 0xfeff) || (0xfff9 <= c && c <= 0xfffb) ||
-        (0x101fd <= c && c <= 0x101fd) || (0x102e0 <= c && c <= 0x102e0) ||
-        (0x10376 <= c && c <= 0x1037a) || (0x10a01 <= c && c <= 0x10a03) ||
-        (0x10a05 <= c && c <= 0x10a06) || (0x10a0c <= c && c <= 0x10a0f) ||
-        (0x10a38 <= c && c <= 0x10a3a) || (0x10a3f <= c && c <= 0x10a3f) ||
-        (0x10ae5 <= c && c <= 0x10ae6) || (0x10d24 <= c && c <= 0x10d27) ||
-        (0x10eab <= c && c <= 0x10eac) || (0x10efd <= c && c <= 0x10eff) ||
-        (0x10f46 <= c && c <= 0x10f50) || (0x10f82 <= c && c <= 0x10f85) ||
-        (0x11001 <= c && c <= 0x11001) || (0x11038 <= c && c <= 0x11046) ||
-        (0x11070 <= c && c <= 0x11070) || (0x11073 <= c && c <= 0x11074) ||
-        (0x1107f <= c && c <= 0x11081) || (0x110b3 <= c && c <= 0x110b6) ||
-        (0x110b9 <= c && c <= 0x110ba) || (0x110c2 <= c && c <= 0x110c2) ||
-        (0x11100 <= c && c <= 0x11102) || (0x11127 <= c && c <= 0x1112b) ||
-        (0x1112d <= c && c <= 0x11134) || (0x11173 <= c && c <= 0x11173) ||
-        (0x11180 <= c && c <= 0x11181) || (0x111b6 <= c && c <= 0x111be) ||
-        (0x111c9 <= c && c <= 0x111cc) || (0x111cf <= c && c <= 0x111cf) ||
-        (0x1122f <= c && c <= 0x11231) || (0x11234 <= c && c <= 0x11234) ||
-        (0x11236 <= c && c <= 0x11237) || (0x1123e <= c && c <= 0x1123e) ||
-        (0x11241 <= c && c <= 0x11241) || (0x112df <= c && c <= 0x112df) ||
-        (0x112e3 <= c && c <= 0x112ea) || (0x11300 <= c && c <= 0x11301) ||
-        (0x1133b <= c && c <= 0x1133c) || (0x11340 <= c && c <= 0x11340) ||
-        (0x11366 <= c && c <= 0x1136c) || (0x11370 <= c && c <= 0x11374) ||
-        (0x11438 <= c && c <= 0x1143f) || (0x11442 <= c && c <= 0x11444) ||
-        (0x11446 <= c && c <= 0x11446) || (0x1145e <= c && c <= 0x1145e) ||
-        (0x114b3 <= c && c <= 0x114b8) || (0x114ba <= c && c <= 0x114ba) ||
-        (0x114bf <= c && c <= 0x114c0) || (0x114c2 <= c && c <= 0x114c3) ||
-        (0x115b2 <= c && c <= 0x115b5) || (0x115bc <= c && c <= 0x115bd) ||
-        (0x115bf <= c && c <= 0x115c0) || (0x115dc <= c && c <= 0x115dd) ||
-        (0x11633 <= c && c <= 0x1163a) || (0x1163d <= c && c <= 0x1163d) ||
-        (0x1163f <= c && c <= 0x11640) || (0x116ab <= c && c <= 0x116ab) ||
-        (0x116ad <= c && c <= 0x116ad) || (0x116b0 <= c && c <= 0x116b5) ||
-        (0x116b7 <= c && c <= 0x116b7) || (0x1171d <= c && c <= 0x1171f) ||
-        (0x11722 <= c && c <= 0x11725) || (0x11727 <= c && c <= 0x1172b) ||
-        (0x1182f <= c && c <= 0x11837) || (0x11839 <= c && c <= 0x1183a) ||
-        (0x1193b <= c && c <= 0x1193c) || (0x1193e <= c && c <= 0x1193e) ||
-        (0x11943 <= c && c <= 0x11943) || (0x119d4 <= c && c <= 0x119d7) ||
-        (0x119da <= c && c <= 0x119db) || (0x119e0 <= c && c <= 0x119e0) ||
-        (0x11a01 <= c && c <= 0x11a0a) || (0x11a33 <= c && c <= 0x11a38) ||
-        (0x11a3b <= c && c <= 0x11a3e) || (0x11a47 <= c && c <= 0x11a47) ||
-        (0x11a51 <= c && c <= 0x11a56) || (0x11a59 <= c && c <= 0x11a5b) ||
-        (0x11a8a <= c && c <= 0x11a96) || (0x11a98 <= c && c <= 0x11a99) ||
-        (0x11c30 <= c && c <= 0x11c36) || (0x11c38 <= c && c <= 0x11c3d) ||
-        (0x11c3f <= c && c <= 0x11c3f) || (0x11c92 <= c && c <= 0x11ca7) ||
-        (0x11caa <= c && c <= 0x11cb0) || (0x11cb2 <= c && c <= 0x11cb3) ||
-        (0x11cb5 <= c && c <= 0x11cb6) || (0x11d31 <= c && c <= 0x11d36) ||
-        (0x11d3a <= c && c <= 0x11d3a) || (0x11d3c <= c && c <= 0x11d3d) ||
-        (0x11d3f <= c && c <= 0x11d45) || (0x11d47 <= c && c <= 0x11d47) ||
-        (0x11d90 <= c && c <= 0x11d91) || (0x11d95 <= c && c <= 0x11d95) ||
-        (0x11d97 <= c && c <= 0x11d97) || (0x11ef3 <= c && c <= 0x11ef4) ||
-        (0x11f00 <= c && c <= 0x11f01) || (0x11f36 <= c && c <= 0x11f3a) ||
-        (0x11f40 <= c && c <= 0x11f40) || (0x11f42 <= c && c <= 0x11f42) ||
-        (0x13430 <= c && c <= 0x13440) || (0x13447 <= c && c <= 0x13455) ||
-        (0x16af0 <= c && c <= 0x16af4) || (0x16b30 <= c && c <= 0x16b36) ||
-        (0x16f4f <= c && c <= 0x16f4f) || (0x16f8f <= c && c <= 0x16f92) ||
-        (0x16fe4 <= c && c <= 0x16fe4) || (0x1bc9d <= c && c <= 0x1bc9e) ||
-        (0x1bca0 <= c && c <= 0x1bca3) || (0x1cf00 <= c && c <= 0x1cf2d) ||
-        (0x1cf30 <= c && c <= 0x1cf46) || (0x1d167 <= c && c <= 0x1d169) ||
-        (0x1d173 <= c && c <= 0x1d182) || (0x1d185 <= c && c <= 0x1d18b) ||
-        (0x1d1aa <= c && c <= 0x1d1ad) || (0x1d242 <= c && c <= 0x1d244) ||
-        (0x1da00 <= c && c <= 0x1da36) || (0x1da3b <= c && c <= 0x1da6c) ||
-        (0x1da75 <= c && c <= 0x1da75) || (0x1da84 <= c && c <= 0x1da84) ||
-        (0x1da9b <= c && c <= 0x1da9f) || (0x1daa1 <= c && c <= 0x1daaf) ||
-        (0x1e000 <= c && c <= 0x1e006) || (0x1e008 <= c && c <= 0x1e018) ||
-        (0x1e01b <= c && c <= 0x1e021) || (0x1e023 <= c && c <= 0x1e024) ||
-        (0x1e026 <= c && c <= 0x1e02a) || (0x1e08f <= c && c <= 0x1e08f) ||
-        (0x1e130 <= c && c <= 0x1e136) || (0x1e2ae <= c && c <= 0x1e2ae) ||
-        (0x1e2ec <= c && c <= 0x1e2ef) || (0x1e4ec <= c && c <= 0x1e4ef) ||
-        (0x1e8d0 <= c && c <= 0x1e8d6) || (0x1e944 <= c && c <= 0x1e94a) ||
-        (0xe0001 <= c && c <= 0xe0001) || (0xe0020 <= c && c <= 0xe007f) ||
-        (0xe0100 <= c && c <= 0xe01ef))
-        return 0;
-    if ((0x1100 <= c && c <= 0x115f) || (0x231a <= c && c <= 0x231b) ||
-        (0x2329 <= c && c <= 0x232a) || (0x23e9 <= c && c <= 0x23ec) ||
-        (0x23f0 <= c && c <= 0x23f0) || (0x23f3 <= c && c <= 0x23f3) ||
-        (0x25fd <= c && c <= 0x25fe) || (0x2614 <= c && c <= 0x2615) ||
-        (0x2648 <= c && c <= 0x2653) || (0x267f <= c && c <= 0x267f) ||
-        (0x2693 <= c && c <= 0x2693) || (0x26a1 <= c && c <= 0x26a1) ||
-        (0x26aa <= c && c <= 0x26ab) || (0x26bd <= c && c <= 0x26be) ||
-        (0x26c4 <= c && c <= 0x26c5) || (0x26ce <= c && c <= 0x26ce) ||
-        (0x26d4 <= c && c <= 0x26d4) || (0x26ea <= c && c <= 0x26ea) ||
-        (0x26f2 <= c && c <= 0x26f3) || (0x26f5 <= c && c <= 0x26f5) ||
-        (0x26fa <= c && c <= 0x26fa) || (0x26fd <= c && c <= 0x26fd) ||
-        (0x2705 <= c && c <= 0x2705) || (0x270a <= c && c <= 0x270b) ||
-        (0x2728 <= c && c <= 0x2728) || (0x274c <= c && c <= 0x274c) ||
-        (0x274e <= c && c <= 0x274e) || (0x2753 <= c && c <= 0x2755) ||
-        (0x2757 <= c && c <= 0x2757) || (0x2795 <= c && c <= 0x2797) ||
-        (0x27b0 <= c && c <= 0x27b0) || (0x27bf <= c && c <= 0x27bf) ||
-        (0x2b1b <= c && c <= 0x2b1c) || (0x2b50 <= c && c <= 0x2b50) ||
-        (0x2b55 <= c && c <= 0x2b55) || (0x2e80 <= c && c <= 0x2e99) ||
-        (0x2e9b <= c && c <= 0x2ef3) || (0x2f00 <= c && c <= 0x2fd5) ||
-        (0x2ff0 <= c && c <= 0x3029) || (0x302e <= c && c <= 0x303e) ||
-        (0x3041 <= c && c <= 0x3096) || (0x309b <= c && c <= 0x30ff) ||
-        (0x3105 <= c && c <= 0x312f) || (0x3131 <= c && c <= 0x318e) ||
-        (0x3190 <= c && c <= 0x31e3) || (0x31ef <= c && c <= 0x321e) ||
-        (0x3220 <= c && c <= 0xa48c) || (0xa490 <= c && c <= 0xa4c6) ||
-        (0xa960 <= c && c <= 0xa97c) || (0xac00 <= c && c <= 0xd7a3) ||
-        (0xf900 <= c && c <= 0xfa6d) || (0xfa70 <= c && c <= 0xfad9) ||
-        (0xfe10 <= c && c <= 0xfe19) || (0xfe30 <= c && c <= 0xfe52) ||
-        (0xfe54 <= c && c <= 0xfe66) || (0xfe68 <= c && c <= 0xfe6b) ||
-        (0xff01 <= c && c <= 0xff60) || (0xffe0 <= c && c <= 0xffe6) ||
-        (0x16fe0 <= c && c <= 0x16fe3) || (0x16ff0 <= c && c <= 0x16ff1) ||
-        (0x17000 <= c && c <= 0x187f7) || (0x18800 <= c && c <= 0x18cd5) ||
-        (0x18d00 <= c && c <= 0x18d08) || (0x1aff0 <= c && c <= 0x1aff3) ||
-        (0x1aff5 <= c && c <= 0x1affb) || (0x1affd <= c && c <= 0x1affe) ||
-        (0x1b000 <= c && c <= 0x1b122) || (0x1b132 <= c && c <= 0x1b132) ||
-        (0x1b150 <= c && c <= 0x1b152) || (0x1b155 <= c && c <= 0x1b155) ||
-        (0x1b164 <= c && c <= 0x1b167) || (0x1b170 <= c && c <= 0x1b2fb) ||
-        (0x1f004 <= c && c <= 0x1f004) || (0x1f0cf <= c && c <= 0x1f0cf) ||
-        (0x1f18e <= c && c <= 0x1f18e) || (0x1f191 <= c && c <= 0x1f19a) ||
-        (0x1f200 <= c && c <= 0x1f202) || (0x1f210 <= c && c <= 0x1f23b) ||
-        (0x1f240 <= c && c <= 0x1f248) || (0x1f250 <= c && c <= 0x1f251) ||
-        (0x1f260 <= c && c <= 0x1f265) || (0x1f300 <= c && c <= 0x1f320) ||
-        (0x1f32d <= c && c <= 0x1f335) || (0x1f337 <= c && c <= 0x1f37c) ||
-        (0x1f37e <= c && c <= 0x1f393) || (0x1f3a0 <= c && c <= 0x1f3ca) ||
-        (0x1f3cf <= c && c <= 0x1f3d3) || (0x1f3e0 <= c && c <= 0x1f3f0) ||
-        (0x1f3f4 <= c && c <= 0x1f3f4) || (0x1f3f8 <= c && c <= 0x1f43e) ||
-        (0x1f440 <= c && c <= 0x1f440) || (0x1f442 <= c && c <= 0x1f4fc) ||
-        (0x1f4ff <= c && c <= 0x1f53d) || (0x1f54b <= c && c <= 0x1f54e) ||
-        (0x1f550 <= c && c <= 0x1f567) || (0x1f57a <= c && c <= 0x1f57a) ||
-        (0x1f595 <= c && c <= 0x1f596) || (0x1f5a4 <= c && c <= 0x1f5a4) ||
-        (0x1f5fb <= c && c <= 0x1f64f) || (0x1f680 <= c && c <= 0x1f6c5) ||
-        (0x1f6cc <= c && c <= 0x1f6cc) || (0x1f6d0 <= c && c <= 0x1f6d2) ||
-        (0x1f6d5 <= c && c <= 0x1f6d7) || (0x1f6dc <= c && c <= 0x1f6df) ||
-        (0x1f6eb <= c && c <= 0x1f6ec) || (0x1f6f4 <= c && c <= 0x1f6fc) ||
-        (0x1f7e0 <= c && c <= 0x1f7eb) || (0x1f7f0 <= c && c <= 0x1f7f0) ||
-        (0x1f90c <= c && c <= 0x1f93a) || (0x1f93c <= c && c <= 0x1f945) ||
-        (0x1f947 <= c && c <= 0x1f9ff) || (0x1fa70 <= c && c <= 0x1fa7c) ||
-        (0x1fa80 <= c && c <= 0x1fa88) || (0x1fa90 <= c && c <= 0x1fabd) ||
-        (0x1fabf <= c && c <= 0x1fac5) || (0x1face <= c && c <= 0x1fadb) ||
-        (0x1fae0 <= c && c <= 0x1fae8) || (0x1faf0 <= c && c <= 0x1faf8) ||
-        (0x20000 <= c && c <= 0x2a6df) || (0x2a700 <= c && c <= 0x2b739) ||
-        (0x2b740 <= c && c <= 0x2b81d) || (0x2b820 <= c && c <= 0x2cea1) ||
-        (0x2ceb0 <= c && c <= 0x2ebe0) || (0x2ebf0 <= c && c <= 0x2ee5d) ||
-        (0x2f800 <= c && c <= 0x2fa1d) || (0x30000 <= c && c <= 0x3134a) ||
-        (0x31350 <= c && c <= 0x323af))
-        return 2;
-    return 1;
+    unsigned b;
+    if (c < 0 || c >= 0x110000)
+        return 1;
+    b = kWidthStage3[kWidthStage2[kWidthStage1[c >> 12]][c >> 6 & 63]][c >> 2 & 15];
+    return b >> ((c & 3) * 2) & 3;
 }
 
 /**
@@ -536,843 +1949,159 @@ int bestlineCharacterWidth(int c) {
  * Line reading interfaces generally define this operation as UNICODE
  * characters that aren't in the letter category (Lu, Ll, Lt, Lm, Lo)
  * and aren't in the number categorie (Nd, Nl, No). We also add a few
- * other things like blocks and emoji (So).
+ * other things like combining marks (Mn, Mc, Me) so accents stay with
+ * their words, as well as blocks and emoji (So).
  */
 char bestlineIsSeparator(unsigned c) {
-    int m, l, r, n;
+    unsigned b;
     if (c < 0200) {
         return !(('0' <= c && c <= '9') || ('A' <= c && c <= 'Z') || ('a' <= c && c <= 'z'));
     }
-    if (c <= 0xffff) {
-        static const unsigned short kGlyphs[][2] = {
-            {0x00aa, 0x00aa}, /*     1x English */
-            {0x00b2, 0x00b3}, /*     2x English Arabic */
-            {0x00b5, 0x00b5}, /*     1x Greek */
-            {0x00b9, 0x00ba}, /*     2x English Arabic */
-            {0x00bc, 0x00be}, /*     3x Vulgar English Arabic */
-            {0x00c0, 0x00d6}, /*    23x Watin */
-            {0x00d8, 0x00f6}, /*    31x Watin */
-            {0x0100, 0x02c1}, /*   450x Watin-AB,IPA,Spacemod */
-            {0x02c6, 0x02d1}, /*    12x Spacemod */
-            {0x02e0, 0x02e4}, /*     5x Spacemod */
-            {0x02ec, 0x02ec}, /*     1x Spacemod */
-            {0x02ee, 0x02ee}, /*     1x Spacemod */
-            {0x0370, 0x0374}, /*     5x Greek */
-            {0x0376, 0x0377}, /*     2x Greek */
-            {0x037a, 0x037d}, /*     4x Greek */
-            {0x037f, 0x037f}, /*     1x Greek */
-            {0x0386, 0x0386}, /*     1x Greek */
-            {0x0388, 0x038a}, /*     3x Greek */
-            {0x038c, 0x038c}, /*     1x Greek */
-            {0x038e, 0x03a1}, /*    20x Greek */
-            {0x03a3, 0x03f5}, /*    83x Greek */
-            {0x03f7, 0x0481}, /*   139x Greek */
-            {0x048a, 0x052f}, /*   166x Cyrillic */
-            {0x0531, 0x0556}, /*    38x Armenian */
-            {0x0560, 0x0588}, /*    41x Armenian */
-            {0x05d0, 0x05ea}, /*    27x Hebrew */
-            {0x0620, 0x064a}, /*    43x Arabic */
-            {0x0660, 0x0669}, /*    10x Arabic */
-            {0x0671, 0x06d3}, /*    99x Arabic */
-            {0x06ee, 0x06fc}, /*    15x Arabic */
-            {0x0712, 0x072f}, /*    30x Syriac */
-            {0x074d, 0x07a5}, /*    89x Syriac,Arabic2,Thaana */
-            {0x07c0, 0x07ea}, /*    43x NKo */
-            {0x0800, 0x0815}, /*    22x Samaritan */
-            {0x0840, 0x0858}, /*    25x Mandaic */
-            {0x0904, 0x0939}, /*    54x Devanagari */
-            {0x0993, 0x09a8}, /*    22x Bengali */
-            {0x09e6, 0x09f1}, /*    12x Bengali */
-            {0x0a13, 0x0a28}, /*    22x Gurmukhi */
-            {0x0a66, 0x0a6f}, /*    10x Gurmukhi */
-            {0x0a93, 0x0aa8}, /*    22x Gujarati */
-            {0x0b13, 0x0b28}, /*    22x Oriya */
-            {0x0c92, 0x0ca8}, /*    23x Kannada */
-            {0x0caa, 0x0cb3}, /*    10x Kannada */
-            {0x0ce6, 0x0cef}, /*    10x Kannada */
-            {0x0d12, 0x0d3a}, /*    41x Malayalam */
-            {0x0d85, 0x0d96}, /*    18x Sinhala */
-            {0x0d9a, 0x0db1}, /*    24x Sinhala */
-            {0x0de6, 0x0def}, /*    10x Sinhala */
-            {0x0e01, 0x0e30}, /*    48x Thai */
-            {0x0e8c, 0x0ea3}, /*    24x Lao */
-            {0x0f20, 0x0f33}, /*    20x Tibetan */
-            {0x0f49, 0x0f6c}, /*    36x Tibetan */
-            {0x109e, 0x10c5}, /*    40x Myanmar,Georgian */
-            {0x10d0, 0x10fa}, /*    43x Georgian */
-            {0x10fc, 0x1248}, /*   333x Georgian,Hangul,Ethiopic */
-            {0x13a0, 0x13f5}, /*    86x Cherokee */
-            {0x1401, 0x166d}, /*   621x Aboriginal */
-            {0x16a0, 0x16ea}, /*    75x Runic */
-            {0x1700, 0x170c}, /*    13x Tagalog */
-            {0x1780, 0x17b3}, /*    52x Khmer */
-            {0x1820, 0x1878}, /*    89x Mongolian */
-            {0x1a00, 0x1a16}, /*    23x Buginese */
-            {0x1a20, 0x1a54}, /*    53x Tai Tham */
-            {0x1a80, 0x1a89}, /*    10x Tai Tham */
-            {0x1a90, 0x1a99}, /*    10x Tai Tham */
-            {0x1b05, 0x1b33}, /*    47x Balinese */
-            {0x1b50, 0x1b59}, /*    10x Balinese */
-            {0x1b83, 0x1ba0}, /*    30x Sundanese */
-            {0x1bae, 0x1be5}, /*    56x Sundanese */
-            {0x1c90, 0x1cba}, /*    43x Georgian2 */
-            {0x1cbd, 0x1cbf}, /*     3x Georgian2 */
-            {0x1e00, 0x1f15}, /*   278x Watin-C,Greek2 */
-            {0x2070, 0x2071}, /*     2x Supersub */
-            {0x2074, 0x2079}, /*     6x Supersub */
-            {0x207f, 0x2089}, /*    11x Supersub */
-            {0x2090, 0x209c}, /*    13x Supersub */
-            {0x2100, 0x2117}, /*    24x Letterlike */
-            {0x2119, 0x213f}, /*    39x Letterlike */
-            {0x2145, 0x214a}, /*     6x Letterlike */
-            {0x214c, 0x218b}, /*    64x Letterlike,Numbery */
-            {0x21af, 0x21cd}, /*    31x Arrows */
-            {0x21d5, 0x21f3}, /*    31x Arrows */
-            {0x230c, 0x231f}, /*    20x Technical */
-            {0x232b, 0x237b}, /*    81x Technical */
-            {0x237d, 0x239a}, /*    30x Technical */
-            {0x23b4, 0x23db}, /*    40x Technical */
-            {0x23e2, 0x2426}, /*    69x Technical,ControlPictures */
-            {0x2460, 0x25b6}, /*   343x Enclosed,Boxes,Blocks,Shapes */
-            {0x25c2, 0x25f7}, /*    54x Shapes */
-            {0x2600, 0x266e}, /*   111x Symbols */
-            {0x2670, 0x2767}, /*   248x Symbols,Dingbats */
-            {0x2776, 0x27bf}, /*    74x Dingbats */
-            {0x2800, 0x28ff}, /*   256x Braille */
-            {0x2c00, 0x2c2e}, /*    47x Glagolitic */
-            {0x2c30, 0x2c5e}, /*    47x Glagolitic */
-            {0x2c60, 0x2ce4}, /*   133x Watin-D */
-            {0x2d00, 0x2d25}, /*    38x Georgian2 */
-            {0x2d30, 0x2d67}, /*    56x Tifinagh */
-            {0x2d80, 0x2d96}, /*    23x Ethiopic2 */
-            {0x2e2f, 0x2e2f}, /*     1x Punctuation2 */
-            {0x3005, 0x3007}, /*     3x CJK Symbols & Punctuation */
-            {0x3021, 0x3029}, /*     9x CJK Symbols & Punctuation */
-            {0x3031, 0x3035}, /*     5x CJK Symbols & Punctuation */
-            {0x3038, 0x303c}, /*     5x CJK Symbols & Punctuation */
-            {0x3041, 0x3096}, /*    86x Hiragana */
-            {0x30a1, 0x30fa}, /*    90x Katakana */
-            {0x3105, 0x312f}, /*    43x Bopomofo */
-            {0x3131, 0x318e}, /*    94x Hangul Compatibility Jamo */
-            {0x31a0, 0x31ba}, /*    27x Bopomofo Extended */
-            {0x31f0, 0x31ff}, /*    16x Katakana Phonetic Extensions */
-            {0x3220, 0x3229}, /*    10x Enclosed CJK Letters & Months */
-            {0x3248, 0x324f}, /*     8x Enclosed CJK Letters & Months */
-            {0x3251, 0x325f}, /*    15x Enclosed CJK Letters & Months */
-            {0x3280, 0x3289}, /*    10x Enclosed CJK Letters & Months */
-            {0x32b1, 0x32bf}, /*    15x Enclosed CJK Letters & Months */
-            {0x3400, 0x4db5}, /*  6582x CJK Unified Ideographs Extension A */
-            {0x4dc0, 0x9fef}, /* 21040x Yijing Hexagram, CJK Unified Ideographs */
-            {0xa000, 0xa48c}, /*  1165x Yi Syllables */
-            {0xa4d0, 0xa4fd}, /*    46x Lisu */
-            {0xa500, 0xa60c}, /*   269x Vai */
-            {0xa610, 0xa62b}, /*    28x Vai */
-            {0xa6a0, 0xa6ef}, /*    80x Bamum */
-            {0xa80c, 0xa822}, /*    23x Syloti Nagri */
-            {0xa840, 0xa873}, /*    52x Phags-pa */
-            {0xa882, 0xa8b3}, /*    50x Saurashtra */
-            {0xa8d0, 0xa8d9}, /*    10x Saurashtra */
-            {0xa900, 0xa925}, /*    38x Kayah Li */
-            {0xa930, 0xa946}, /*    23x Rejang */
-            {0xa960, 0xa97c}, /*    29x Hangul Jamo Extended-A */
-            {0xa984, 0xa9b2}, /*    47x Javanese */
-            {0xa9cf, 0xa9d9}, /*    11x Javanese */
-            {0xaa00, 0xaa28}, /*    41x Cham */
-            {0xaa50, 0xaa59}, /*    10x Cham */
-            {0xabf0, 0xabf9}, /*    10x Meetei Mayek */
-            {0xac00, 0xd7a3}, /* 11172x Hangul Syllables */
-            {0xf900, 0xfa6d}, /*   366x CJK Compatibility Ideographs */
-            {0xfa70, 0xfad9}, /*   106x CJK Compatibility Ideographs */
-            {0xfb1f, 0xfb28}, /*    10x Alphabetic Presentation Forms */
-            {0xfb2a, 0xfb36}, /*    13x Alphabetic Presentation Forms */
-            {0xfb46, 0xfbb1}, /*   108x Alphabetic Presentation Forms */
-            {0xfbd3, 0xfd3d}, /*   363x Arabic Presentation Forms-A */
-            {0xfe76, 0xfefc}, /*   135x Arabic Presentation Forms-B */
-            {0xff10, 0xff19}, /*    10x Dubs */
-            {0xff21, 0xff3a}, /*    26x Dubs */
-            {0xff41, 0xff5a}, /*    26x Dubs */
-            {0xff66, 0xffbe}, /*    89x Dubs */
-            {0xffc2, 0xffc7}, /*     6x Dubs */
-            {0xffca, 0xffcf}, /*     6x Dubs */
-            {0xffd2, 0xffd7}, /*     6x Dubs */
-            {0xffda, 0xffdc}, /*     3x Dubs */
-        };
-        l = 0;
-        r = n = sizeof(kGlyphs) / sizeof(kGlyphs[0]);
-        while (l < r) {
-            unsigned m = (l & r) + ((l ^ r) >> 1);
-            if (c < kGlyphs[m][0]) {
-                r = m;
-            } else if (c > kGlyphs[m][1]) {
-                l = m + 1;
-            } else {
-                return 0;
-            }
-        }
-        return 1;
-    } else {
-        static const unsigned kAstralGlyphs[][2] = {
-            {0x10107, 0x10133}, /*    45x Aegean */
-            {0x10140, 0x10178}, /*    57x Ancient Greek Numbers */
-            {0x1018a, 0x1018b}, /*     2x Ancient Greek Numbers */
-            {0x10280, 0x1029c}, /*    29x Lycian */
-            {0x102a0, 0x102d0}, /*    49x Carian */
-            {0x102e1, 0x102fb}, /*    27x Coptic Epact Numbers */
-            {0x10300, 0x10323}, /*    36x Old Italic */
-            {0x1032d, 0x1034a}, /*    30x Old Italic, Gothic */
-            {0x10350, 0x10375}, /*    38x Old Permic */
-            {0x10380, 0x1039d}, /*    30x Ugaritic */
-            {0x103a0, 0x103c3}, /*    36x Old Persian */
-            {0x103c8, 0x103cf}, /*     8x Old Persian */
-            {0x103d1, 0x103d5}, /*     5x Old Persian */
-            {0x10400, 0x1049d}, /*    158x Deseret, Shavian, Osmanya */
-            {0x104b0, 0x104d3}, /*    36x Osage */
-            {0x104d8, 0x104fb}, /*    36x Osage */
-            {0x10500, 0x10527}, /*    40x Elbasan */
-            {0x10530, 0x10563}, /*    52x Caucasian Albanian */
-            {0x10600, 0x10736}, /*   311x Linear A */
-            {0x10800, 0x10805}, /*     6x Cypriot Syllabary */
-            {0x1080a, 0x10835}, /*    44x Cypriot Syllabary */
-            {0x10837, 0x10838}, /*     2x Cypriot Syllabary */
-            {0x1083f, 0x1089e}, /*    86x Cypriot,ImperialAramaic,Palmyrene,Nabataean */
-            {0x108e0, 0x108f2}, /*    19x Hatran */
-            {0x108f4, 0x108f5}, /*     2x Hatran */
-            {0x108fb, 0x1091b}, /*    33x Hatran */
-            {0x10920, 0x10939}, /*    26x Lydian */
-            {0x10980, 0x109b7}, /*    56x Meroitic Hieroglyphs */
-            {0x109bc, 0x109cf}, /*    20x Meroitic Cursive */
-            {0x109d2, 0x10a00}, /*    47x Meroitic Cursive */
-            {0x10a10, 0x10a13}, /*     4x Kharoshthi */
-            {0x10a15, 0x10a17}, /*     3x Kharoshthi */
-            {0x10a19, 0x10a35}, /*    29x Kharoshthi */
-            {0x10a40, 0x10a48}, /*     9x Kharoshthi */
-            {0x10a60, 0x10a7e}, /*    31x Old South Arabian */
-            {0x10a80, 0x10a9f}, /*    32x Old North Arabian */
-            {0x10ac0, 0x10ac7}, /*     8x Manichaean */
-            {0x10ac9, 0x10ae4}, /*    28x Manichaean */
-            {0x10aeb, 0x10aef}, /*     5x Manichaean */
-            {0x10b00, 0x10b35}, /*    54x Avestan */
-            {0x10b40, 0x10b55}, /*    22x Inscriptional Parthian */
-            {0x10b58, 0x10b72}, /*    27x Inscriptional Parthian and Pahlavi */
-            {0x10b78, 0x10b91}, /*    26x Inscriptional Pahlavi, Psalter Pahlavi */
-            {0x10c00, 0x10c48}, /*    73x Old Turkic */
-            {0x10c80, 0x10cb2}, /*    51x Old Hungarian */
-            {0x10cc0, 0x10cf2}, /*    51x Old Hungarian */
-            {0x10cfa, 0x10d23}, /*    42x Old Hungarian, Hanifi Rohingya */
-            {0x10d30, 0x10d39}, /*    10x Hanifi Rohingya */
-            {0x10e60, 0x10e7e}, /*    31x Rumi Numeral Symbols */
-            {0x10f00, 0x10f27}, /*    40x Old Sogdian */
-            {0x10f30, 0x10f45}, /*    22x Sogdian */
-            {0x10f51, 0x10f54}, /*     4x Sogdian */
-            {0x10fe0, 0x10ff6}, /*    23x Elymaic */
-            {0x11003, 0x11037}, /*    53x Brahmi */
-            {0x11052, 0x1106f}, /*    30x Brahmi */
-            {0x11083, 0x110af}, /*    45x Kaithi */
-            {0x110d0, 0x110e8}, /*    25x Sora Sompeng */
-            {0x110f0, 0x110f9}, /*    10x Sora Sompeng */
-            {0x11103, 0x11126}, /*    36x Chakma */
-            {0x11136, 0x1113f}, /*    10x Chakma */
-            {0x11144, 0x11144}, /*     1x Chakma */
-            {0x11150, 0x11172}, /*    35x Mahajani */
-            {0x11176, 0x11176}, /*     1x Mahajani */
-            {0x11183, 0x111b2}, /*    48x Sharada */
-            {0x111c1, 0x111c4}, /*     4x Sharada */
-            {0x111d0, 0x111da}, /*    11x Sharada */
-            {0x111dc, 0x111dc}, /*     1x Sharada */
-            {0x111e1, 0x111f4}, /*    20x Sinhala Archaic Numbers */
-            {0x11200, 0x11211}, /*    18x Khojki */
-            {0x11213, 0x1122b}, /*    25x Khojki */
-            {0x11280, 0x11286}, /*     7x Multani */
-            {0x11288, 0x11288}, /*     1x Multani */
-            {0x1128a, 0x1128d}, /*     4x Multani */
-            {0x1128f, 0x1129d}, /*    15x Multani */
-            {0x1129f, 0x112a8}, /*    10x Multani */
-            {0x112b0, 0x112de}, /*    47x Khudawadi */
-            {0x112f0, 0x112f9}, /*    10x Khudawadi */
-            {0x11305, 0x1130c}, /*     8x Grantha */
-            {0x1130f, 0x11310}, /*     2x Grantha */
-            {0x11313, 0x11328}, /*    22x Grantha */
-            {0x1132a, 0x11330}, /*     7x Grantha */
-            {0x11332, 0x11333}, /*     2x Grantha */
-            {0x11335, 0x11339}, /*     5x Grantha */
-            {0x1133d, 0x1133d}, /*     1x Grantha */
-            {0x11350, 0x11350}, /*     1x Grantha */
-            {0x1135d, 0x11361}, /*     5x Grantha */
-            {0x11400, 0x11434}, /*    53x Newa */
-            {0x11447, 0x1144a}, /*     4x Newa */
-            {0x11450, 0x11459}, /*    10x Newa */
-            {0x1145f, 0x1145f}, /*     1x Newa */
-            {0x11480, 0x114af}, /*    48x Tirhuta */
-            {0x114c4, 0x114c5}, /*     2x Tirhuta */
-            {0x114c7, 0x114c7}, /*     1x Tirhuta */
-            {0x114d0, 0x114d9}, /*    10x Tirhuta */
-            {0x11580, 0x115ae}, /*    47x Siddham */
-            {0x115d8, 0x115db}, /*     4x Siddham */
-            {0x11600, 0x1162f}, /*    48x Modi */
-            {0x11644, 0x11644}, /*     1x Modi */
-            {0x11650, 0x11659}, /*    10x Modi */
-            {0x11680, 0x116aa}, /*    43x Takri */
-            {0x116b8, 0x116b8}, /*     1x Takri */
-            {0x116c0, 0x116c9}, /*    10x Takri */
-            {0x11700, 0x1171a}, /*    27x Ahom */
-            {0x11730, 0x1173b}, /*    12x Ahom */
-            {0x11800, 0x1182b}, /*    44x Dogra */
-            {0x118a0, 0x118f2}, /*    83x Warang Citi */
-            {0x118ff, 0x118ff}, /*     1x Warang Citi */
-            {0x119a0, 0x119a7}, /*     8x Nandinagari */
-            {0x119aa, 0x119d0}, /*    39x Nandinagari */
-            {0x119e1, 0x119e1}, /*     1x Nandinagari */
-            {0x119e3, 0x119e3}, /*     1x Nandinagari */
-            {0x11a00, 0x11a00}, /*     1x Zanabazar Square */
-            {0x11a0b, 0x11a32}, /*    40x Zanabazar Square */
-            {0x11a3a, 0x11a3a}, /*     1x Zanabazar Square */
-            {0x11a50, 0x11a50}, /*     1x Soyombo */
-            {0x11a5c, 0x11a89}, /*    46x Soyombo */
-            {0x11a9d, 0x11a9d}, /*     1x Soyombo */
-            {0x11ac0, 0x11af8}, /*    57x Pau Cin Hau */
-            {0x11c00, 0x11c08}, /*     9x Bhaiksuki */
-            {0x11c0a, 0x11c2e}, /*    37x Bhaiksuki */
-            {0x11c40, 0x11c40}, /*     1x Bhaiksuki */
-            {0x11c50, 0x11c6c}, /*    29x Bhaiksuki */
-            {0x11c72, 0x11c8f}, /*    30x Marchen */
-            {0x11d00, 0x11d06}, /*     7x Masaram Gondi */
-            {0x11d08, 0x11d09}, /*     2x Masaram Gondi */
-            {0x11d0b, 0x11d30}, /*    38x Masaram Gondi */
-            {0x11d46, 0x11d46}, /*     1x Masaram Gondi */
-            {0x11d50, 0x11d59}, /*    10x Masaram Gondi */
-            {0x11d60, 0x11d65}, /*     6x Gunjala Gondi */
-            {0x11d67, 0x11d68}, /*     2x Gunjala Gondi */
-            {0x11d6a, 0x11d89}, /*    32x Gunjala Gondi */
-            {0x11d98, 0x11d98}, /*     1x Gunjala Gondi */
-            {0x11da0, 0x11da9}, /*    10x Gunjala Gondi */
-            {0x11ee0, 0x11ef2}, /*    19x Makasar */
-            {0x11fc0, 0x11fd4}, /*    21x Tamil Supplement */
-            {0x12000, 0x12399}, /*   922x Cuneiform */
-            {0x12400, 0x1246e}, /*   111x Cuneiform Numbers & Punctuation */
-            {0x12480, 0x12543}, /*   196x Early Dynastic Cuneiform */
-            {0x13000, 0x1342e}, /*  1071x Egyptian Hieroglyphs */
-            {0x14400, 0x14646}, /*   583x Anatolian Hieroglyphs */
-            {0x16800, 0x16a38}, /*   569x Bamum Supplement */
-            {0x16a40, 0x16a5e}, /*    31x Mro */
-            {0x16a60, 0x16a69}, /*    10x Mro */
-            {0x16ad0, 0x16aed}, /*    30x Bassa Vah */
-            {0x16b00, 0x16b2f}, /*    48x Pahawh Hmong */
-            {0x16b40, 0x16b43}, /*     4x Pahawh Hmong */
-            {0x16b50, 0x16b59}, /*    10x Pahawh Hmong */
-            {0x16b5b, 0x16b61}, /*     7x Pahawh Hmong */
-            {0x16b63, 0x16b77}, /*    21x Pahawh Hmong */
-            {0x16b7d, 0x16b8f}, /*    19x Pahawh Hmong */
-            {0x16e40, 0x16e96}, /*    87x Medefaidrin */
-            {0x16f00, 0x16f4a}, /*    75x Miao */
-            {0x16f50, 0x16f50}, /*     1x Miao */
-            {0x16f93, 0x16f9f}, /*    13x Miao */
-            {0x16fe0, 0x16fe1}, /*     2x Ideographic Symbols & Punctuation */
-            {0x16fe3, 0x16fe3}, /*     1x Ideographic Symbols & Punctuation */
-            {0x17000, 0x187f7}, /*  6136x Tangut */
-            {0x18800, 0x18af2}, /*   755x Tangut Components */
-            {0x1b000, 0x1b11e}, /*   287x Kana Supplement */
-            {0x1b150, 0x1b152}, /*     3x Small Kana Extension */
-            {0x1b164, 0x1b167}, /*     4x Small Kana Extension */
-            {0x1b170, 0x1b2fb}, /*   396x Nushu */
-            {0x1bc00, 0x1bc6a}, /*   107x Duployan */
-            {0x1bc70, 0x1bc7c}, /*    13x Duployan */
-            {0x1bc80, 0x1bc88}, /*     9x Duployan */
-            {0x1bc90, 0x1bc99}, /*    10x Duployan */
-            {0x1d2e0, 0x1d2f3}, /*    20x Mayan Numerals */
-            {0x1d360, 0x1d378}, /*    25x Counting Rod Numerals */
-            {0x1d400, 0x1d454}, /*    85x 𝐀..𝑔 Math */
-            {0x1d456, 0x1d49c}, /*    71x 𝑖..𝒜 Math */
-            {0x1d49e, 0x1d49f}, /*     2x 𝒞..𝒟 Math */
-            {0x1d4a2, 0x1d4a2}, /*     1x 𝒢..𝒢 Math */
-            {0x1d4a5, 0x1d4a6}, /*     2x 𝒥..𝒦 Math */
-            {0x1d4a9, 0x1d4ac}, /*     4x 𝒩..𝒬 Math */
-            {0x1d4ae, 0x1d4b9}, /*    12x 𝒮..𝒹 Math */
-            {0x1d4bb, 0x1d4bb}, /*     1x 𝒻..𝒻 Math */
-            {0x1d4bd, 0x1d4c3}, /*     7x 𝒽..𝓃 Math */
-            {0x1d4c5, 0x1d505}, /*    65x 𝓅..𝔅 Math */
-            {0x1d507, 0x1d50a}, /*     4x 𝔇..𝔊 Math */
-            {0x1d50d, 0x1d514}, /*     8x 𝔍..𝔔 Math */
-            {0x1d516, 0x1d51c}, /*     7x 𝔖..𝔜 Math */
-            {0x1d51e, 0x1d539}, /*    28x 𝔞..𝔹 Math */
-            {0x1d53b, 0x1d53e}, /*     4x 𝔻..𝔾 Math */
-            {0x1d540, 0x1d544}, /*     5x 𝕀..𝕄 Math */
-            {0x1d546, 0x1d546}, /*     1x 𝕆..𝕆 Math */
-            {0x1d54a, 0x1d550}, /*     7x 𝕊..𝕐 Math */
-            {0x1d552, 0x1d6a5}, /*   340x 𝕒..𝚥 Math */
-            {0x1d6a8, 0x1d6c0}, /*    25x 𝚨..𝛀 Math */
-            {0x1d6c2, 0x1d6da}, /*    25x 𝛂..𝛚 Math */
-            {0x1d6dc, 0x1d6fa}, /*    31x 𝛜..𝛺 Math */
-            {0x1d6fc, 0x1d714}, /*    25x 𝛼..𝜔 Math */
-            {0x1d716, 0x1d734}, /*    31x 𝜖..𝜴 Math */
-            {0x1d736, 0x1d74e}, /*    25x 𝜶..𝝎 Math */
-            {0x1d750, 0x1d76e}, /*    31x 𝝐..𝝮 Math */
-            {0x1d770, 0x1d788}, /*    25x 𝝰..𝞈 Math */
-            {0x1d78a, 0x1d7a8}, /*    31x 𝞊..𝞨 Math */
-            {0x1d7aa, 0x1d7c2}, /*    25x 𝞪..𝟂 Math */
-            {0x1d7c4, 0x1d7cb}, /*     8x 𝟄..𝟋 Math */
-            {0x1d7ce, 0x1d9ff}, /*   562x Math, Sutton SignWriting */
-            {0x1f100, 0x1f10c}, /*    13x Enclosed Alphanumeric Supplement */
-            {0x20000, 0x2a6d6}, /* 42711x CJK Unified Ideographs Extension B */
-            {0x2a700, 0x2b734}, /*  4149x CJK Unified Ideographs Extension C */
-            {0x2b740, 0x2b81d}, /*   222x CJK Unified Ideographs Extension D */
-            {0x2b820, 0x2cea1}, /*  5762x CJK Unified Ideographs Extension E */
-            {0x2ceb0, 0x2ebe0}, /*  7473x CJK Unified Ideographs Extension F */
-            {0x2f800, 0x2fa1d}, /*   542x CJK Compatibility Ideographs Supplement */
-        };
-        l = 0;
-        r = n = sizeof(kAstralGlyphs) / sizeof(kAstralGlyphs[0]);
-        while (l < r) {
-            unsigned m = (l & r) + ((l ^ r) >> 1);
-            if (c < kAstralGlyphs[m][0]) {
-                r = m;
-            } else if (c > kAstralGlyphs[m][1]) {
-                l = m + 1;
-            } else {
-                return 0;
-            }
-        }
+    if (c >= 0x110000)
         return 1;
-    }
+    b = kWordStage3[kWordStage2[kWordStage1[c >> 12]][c >> 7 & 31]][c >> 3 & 15];
+    return !(b >> (c & 7) & 1);
+}
+
+/**
+ * Returns 𝑐 moved by column 𝑘 of its kDelta row, or 0 if none.
+ */
+static unsigned GetDelta(unsigned c, int k) {
+    unsigned d;
+    if (c >= sizeof(kDeltaStage1) << 9)
+        return 0;
+    if (!(d = kDelta[kDeltaStage3[kDeltaStage2[kDeltaStage1[c >> 9]][c >> 4 & 31]][c & 15]][k]))
+        return 0;
+    return (c & ~0xffffu) | ((c + d) & 0xffff);
 }
 
 unsigned bestlineLowercase(unsigned c) {
-    int m, l, r, n;
+    unsigned x;
     if (c < 0200) {
         if ('A' <= c && c <= 'Z') {
             return c + 32;
         } else {
             return c;
         }
-    } else if (c <= 0xffff) {
-        if ((0x0100 <= c && c <= 0x0176) || /* 60x Ā..ā → ā..ŵ Watin-A */
-            (0x01de <= c && c <= 0x01ee) || /*  9x Ǟ..Ǯ → ǟ..ǯ Watin-B */
-            (0x01f8 <= c && c <= 0x021e) || /* 20x Ǹ..Ȟ → ǹ..ȟ Watin-B */
-            (0x0222 <= c && c <= 0x0232) || /*  9x Ȣ..Ȳ → ȣ..ȳ Watin-B */
-            (0x1e00 <= c && c <= 0x1eff)) { /*256x Ḁ..Ỿ → ḁ..ỿ Watin-C */
-            if (c == 0x0130)
-                return c - 199;
-            if (c == 0x1e9e)
-                return c;
-            return c + (~c & 1);
-        } else if (0x01cf <= c && c <= 0x01db) {
-            return c + (c & 1); /* 7x Ǐ..Ǜ → ǐ..ǜ Watin-B */
-        } else if (0x13a0 <= c && c <= 0x13ef) {
-            return c + 38864; /* 80x Ꭰ ..Ꮿ  → ꭰ ..ꮿ  Cherokee */
-        } else {
-            static const struct {
-                unsigned short a;
-                unsigned short b;
-                short d;
-            } kLower[] = {
-                {0x00c0, 0x00d6, +32}, /* 23x À ..Ö  → à ..ö  Watin */
-                {0x00d8, 0x00de, +32}, /*  7x Ø ..Þ  → ø ..þ  Watin */
-                {0x0178, 0x0178, -121}, /*  1x Ÿ ..Ÿ  → ÿ ..ÿ  Watin-A */
-                {0x0179, 0x0179, +1}, /*  1x Ź ..Ź  → ź ..ź  Watin-A */
-                {0x017b, 0x017b, +1}, /*  1x Ż ..Ż  → ż ..ż  Watin-A */
-                {0x017d, 0x017d, +1}, /*  1x Ž ..Ž  → ž ..ž  Watin-A */
-                {0x0181, 0x0181, +210}, /*  1x Ɓ ..Ɓ  → ɓ ..ɓ  Watin-B */
-                {0x0182, 0x0182, +1}, /*  1x Ƃ ..Ƃ  → ƃ ..ƃ  Watin-B */
-                {0x0184, 0x0184, +1}, /*  1x Ƅ ..Ƅ  → ƅ ..ƅ  Watin-B */
-                {0x0186, 0x0186, +206}, /*  1x Ɔ ..Ɔ  → ɔ ..ɔ  Watin-B */
-                {0x0187, 0x0187, +1}, /*  1x Ƈ ..Ƈ  → ƈ ..ƈ  Watin-B */
-                {0x0189, 0x018a, +205}, /*  2x Ɖ ..Ɗ  → ɖ ..ɗ  Watin-B */
-                {0x018b, 0x018b, +1}, /*  1x Ƌ ..Ƌ  → ƌ ..ƌ  Watin-B */
-                {0x018e, 0x018e, +79}, /*  1x Ǝ ..Ǝ  → ǝ ..ǝ  Watin-B */
-                {0x018f, 0x018f, +202}, /*  1x Ə ..Ə  → ə ..ə  Watin-B */
-                {0x0190, 0x0190, +203}, /*  1x Ɛ ..Ɛ  → ɛ ..ɛ  Watin-B */
-                {0x0191, 0x0191, +1}, /*  1x Ƒ ..Ƒ  → ƒ ..ƒ  Watin-B */
-                {0x0193, 0x0193, +205}, /*  1x Ɠ ..Ɠ  → ɠ ..ɠ  Watin-B */
-                {0x0194, 0x0194, +207}, /*  1x Ɣ ..Ɣ  → ɣ ..ɣ  Watin-B */
-                {0x0196, 0x0196, +211}, /*  1x Ɩ ..Ɩ  → ɩ ..ɩ  Watin-B */
-                {0x0197, 0x0197, +209}, /*  1x Ɨ ..Ɨ  → ɨ ..ɨ  Watin-B */
-                {0x0198, 0x0198, +1}, /*  1x Ƙ ..Ƙ  → ƙ ..ƙ  Watin-B */
-                {0x019c, 0x019c, +211}, /*  1x Ɯ ..Ɯ  → ɯ ..ɯ  Watin-B */
-                {0x019d, 0x019d, +213}, /*  1x Ɲ ..Ɲ  → ɲ ..ɲ  Watin-B */
-                {0x019f, 0x019f, +214}, /*  1x Ɵ ..Ɵ  → ɵ ..ɵ  Watin-B */
-                {0x01a0, 0x01a0, +1}, /*  1x Ơ ..Ơ  → ơ ..ơ  Watin-B */
-                {0x01a2, 0x01a2, +1}, /*  1x Ƣ ..Ƣ  → ƣ ..ƣ  Watin-B */
-                {0x01a4, 0x01a4, +1}, /*  1x Ƥ ..Ƥ  → ƥ ..ƥ  Watin-B */
-                {0x01a6, 0x01a6, +218}, /*  1x Ʀ ..Ʀ  → ʀ ..ʀ  Watin-B */
-                {0x01a7, 0x01a7, +1}, /*  1x Ƨ ..Ƨ  → ƨ ..ƨ  Watin-B */
-                {0x01a9, 0x01a9, +218}, /*  1x Ʃ ..Ʃ  → ʃ ..ʃ  Watin-B */
-                {0x01ac, 0x01ac, +1}, /*  1x Ƭ ..Ƭ  → ƭ ..ƭ  Watin-B */
-                {0x01ae, 0x01ae, +218}, /*  1x Ʈ ..Ʈ  → ʈ ..ʈ  Watin-B */
-                {0x01af, 0x01af, +1}, /*  1x Ư ..Ư  → ư ..ư  Watin-B */
-                {0x01b1, 0x01b2, +217}, /*  2x Ʊ ..Ʋ  → ʊ ..ʋ  Watin-B */
-                {0x01b3, 0x01b3, +1}, /*  1x Ƴ ..Ƴ  → ƴ ..ƴ  Watin-B */
-                {0x01b5, 0x01b5, +1}, /*  1x Ƶ ..Ƶ  → ƶ ..ƶ  Watin-B */
-                {0x01b7, 0x01b7, +219}, /*  1x Ʒ ..Ʒ  → ʒ ..ʒ  Watin-B */
-                {0x01b8, 0x01b8, +1}, /*  1x Ƹ ..Ƹ  → ƹ ..ƹ  Watin-B */
-                {0x01bc, 0x01bc, +1}, /*  1x Ƽ ..Ƽ  → ƽ ..ƽ  Watin-B */
-                {0x01c4, 0x01c4, +2}, /*  1x Ǆ ..Ǆ  → ǆ ..ǆ  Watin-B */
-                {0x01c5, 0x01c5, +1}, /*  1x ǅ ..ǅ  → ǆ ..ǆ  Watin-B */
-                {0x01c7, 0x01c7, +2}, /*  1x Ǉ ..Ǉ  → ǉ ..ǉ  Watin-B */
-                {0x01c8, 0x01c8, +1}, /*  1x ǈ ..ǈ  → ǉ ..ǉ  Watin-B */
-                {0x01ca, 0x01ca, +2}, /*  1x Ǌ ..Ǌ  → ǌ ..ǌ  Watin-B */
-                {0x01cb, 0x01cb, +1}, /*  1x ǋ ..ǋ  → ǌ ..ǌ  Watin-B */
-                {0x01cd, 0x01cd, +1}, /*  1x Ǎ ..Ǎ  → ǎ ..ǎ  Watin-B */
-                {0x01f1, 0x01f1, +2}, /*  1x Ǳ ..Ǳ  → ǳ ..ǳ  Watin-B */
-                {0x01f2, 0x01f2, +1}, /*  1x ǲ ..ǲ  → ǳ ..ǳ  Watin-B */
-                {0x01f4, 0x01f4, +1}, /*  1x Ǵ ..Ǵ  → ǵ ..ǵ  Watin-B */
-                {0x01f6, 0x01f6, -97}, /*  1x Ƕ ..Ƕ  → ƕ ..ƕ  Watin-B */
-                {0x01f7, 0x01f7, -56}, /*  1x Ƿ ..Ƿ  → ƿ ..ƿ  Watin-B */
-                {0x0220, 0x0220, -130}, /*  1x Ƞ ..Ƞ  → ƞ ..ƞ  Watin-B */
-                {0x023b, 0x023b, +1}, /*  1x Ȼ ..Ȼ  → ȼ ..ȼ  Watin-B */
-                {0x023d, 0x023d, -163}, /*  1x Ƚ ..Ƚ  → ƚ ..ƚ  Watin-B */
-                {0x0241, 0x0241, +1}, /*  1x Ɂ ..Ɂ  → ɂ ..ɂ  Watin-B */
-                {0x0243, 0x0243, -195}, /*  1x Ƀ ..Ƀ  → ƀ ..ƀ  Watin-B */
-                {0x0244, 0x0244, +69}, /*  1x Ʉ ..Ʉ  → ʉ ..ʉ  Watin-B */
-                {0x0245, 0x0245, +71}, /*  1x Ʌ ..Ʌ  → ʌ ..ʌ  Watin-B */
-                {0x0246, 0x0246, +1}, /*  1x Ɇ ..Ɇ  → ɇ ..ɇ  Watin-B */
-                {0x0248, 0x0248, +1}, /*  1x Ɉ ..Ɉ  → ɉ ..ɉ  Watin-B */
-                {0x024a, 0x024a, +1}, /*  1x Ɋ ..Ɋ  → ɋ ..ɋ  Watin-B */
-                {0x024c, 0x024c, +1}, /*  1x Ɍ ..Ɍ  → ɍ ..ɍ  Watin-B */
-                {0x024e, 0x024e, +1}, /*  1x Ɏ ..Ɏ  → ɏ ..ɏ  Watin-B */
-                {0x0386, 0x0386, +38}, /*  1x Ά ..Ά  → ά ..ά  Greek */
-                {0x0388, 0x038a, +37}, /*  3x Έ ..Ί  → έ ..ί  Greek */
-                {0x038c, 0x038c, +64}, /*  1x Ό ..Ό  → ό ..ό  Greek */
-                {0x038e, 0x038f, +63}, /*  2x Ύ ..Ώ  → ύ ..ώ  Greek */
-                {0x0391, 0x03a1, +32}, /* 17x Α ..Ρ  → α ..ρ  Greek */
-                {0x03a3, 0x03ab, +32}, /*  9x Σ ..Ϋ  → σ ..ϋ  Greek */
-                {0x03dc, 0x03dc, +1}, /*  1x Ϝ ..Ϝ  → ϝ ..ϝ  Greek */
-                {0x03f4, 0x03f4, -60}, /*  1x ϴ ..ϴ  → θ ..θ  Greek */
-                {0x0400, 0x040f, +80}, /* 16x Ѐ ..Џ  → ѐ ..џ  Cyrillic */
-                {0x0410, 0x042f, +32}, /* 32x А ..Я  → а ..я  Cyrillic */
-                {0x0460, 0x0460, +1}, /*  1x Ѡ ..Ѡ  → ѡ ..ѡ  Cyrillic */
-                {0x0462, 0x0462, +1}, /*  1x Ѣ ..Ѣ  → ѣ ..ѣ  Cyrillic */
-                {0x0464, 0x0464, +1}, /*  1x Ѥ ..Ѥ  → ѥ ..ѥ  Cyrillic */
-                {0x0472, 0x0472, +1}, /*  1x Ѳ ..Ѳ  → ѳ ..ѳ  Cyrillic */
-                {0x0490, 0x0490, +1}, /*  1x Ґ ..Ґ  → ґ ..ґ  Cyrillic */
-                {0x0498, 0x0498, +1}, /*  1x Ҙ ..Ҙ  → ҙ ..ҙ  Cyrillic */
-                {0x049a, 0x049a, +1}, /*  1x Қ ..Қ  → қ ..қ  Cyrillic */
-                {0x0531, 0x0556, +48}, /* 38x Ա ..Ֆ  → ա ..ֆ  Armenian */
-                {0x10a0, 0x10c5, +7264}, /* 38x Ⴀ ..Ⴥ  → ⴀ ..ⴥ  Georgian */
-                {0x10c7, 0x10c7, +7264}, /*  1x Ⴧ ..Ⴧ  → ⴧ ..ⴧ  Georgian */
-                {0x10cd, 0x10cd, +7264}, /*  1x Ⴭ ..Ⴭ  → ⴭ ..ⴭ  Georgian */
-                {0x13f0, 0x13f5, +8}, /*  6x Ᏸ ..Ᏽ  → ᏸ ..ᏽ  Cherokee */
-                {0x1c90, 0x1cba, -3008}, /* 43x Ა ..Ჺ  → ა ..ჺ  Georgian2 */
-                {0x1cbd, 0x1cbf, -3008}, /*  3x Ჽ ..Ჿ  → ჽ ..ჿ  Georgian2 */
-                {0x1f08, 0x1f0f, -8}, /*  8x Ἀ ..Ἇ  → ἀ ..ἇ  Greek2 */
-                {0x1f18, 0x1f1d, -8}, /*  6x Ἐ ..Ἕ  → ἐ ..ἕ  Greek2 */
-                {0x1f28, 0x1f2f, -8}, /*  8x Ἠ ..Ἧ  → ἠ ..ἧ  Greek2 */
-                {0x1f38, 0x1f3f, -8}, /*  8x Ἰ ..Ἷ  → ἰ ..ἷ  Greek2 */
-                {0x1f48, 0x1f4d, -8}, /*  6x Ὀ ..Ὅ  → ὀ ..ὅ  Greek2 */
-                {0x1f59, 0x1f59, -8}, /*  1x Ὑ ..Ὑ  → ὑ ..ὑ  Greek2 */
-                {0x1f5b, 0x1f5b, -8}, /*  1x Ὓ ..Ὓ  → ὓ ..ὓ  Greek2 */
-                {0x1f5d, 0x1f5d, -8}, /*  1x Ὕ ..Ὕ  → ὕ ..ὕ  Greek2 */
-                {0x1f5f, 0x1f5f, -8}, /*  1x Ὗ ..Ὗ  → ὗ ..ὗ  Greek2 */
-                {0x1f68, 0x1f6f, -8}, /*  8x Ὠ ..Ὧ  → ὠ ..ὧ  Greek2 */
-                {0x1f88, 0x1f8f, -8}, /*  8x ᾈ ..ᾏ  → ᾀ ..ᾇ  Greek2 */
-                {0x1f98, 0x1f9f, -8}, /*  8x ᾘ ..ᾟ  → ᾐ ..ᾗ  Greek2 */
-                {0x1fa8, 0x1faf, -8}, /*  8x ᾨ ..ᾯ  → ᾠ ..ᾧ  Greek2 */
-                {0x1fb8, 0x1fb9, -8}, /*  2x Ᾰ ..Ᾱ  → ᾰ ..ᾱ  Greek2 */
-                {0x1fba, 0x1fbb, -74}, /*  2x Ὰ ..Ά  → ὰ ..ά  Greek2 */
-                {0x1fbc, 0x1fbc, -9}, /*  1x ᾼ ..ᾼ  → ᾳ ..ᾳ  Greek2 */
-                {0x1fc8, 0x1fcb, -86}, /*  4x Ὲ ..Ή  → ὲ ..ή  Greek2 */
-                {0x1fcc, 0x1fcc, -9}, /*  1x ῌ ..ῌ  → ῃ ..ῃ  Greek2 */
-                {0x1fd8, 0x1fd9, -8}, /*  2x Ῐ ..Ῑ  → ῐ ..ῑ  Greek2 */
-                {0x1fda, 0x1fdb, -100}, /*  2x Ὶ ..Ί  → ὶ ..ί  Greek2 */
-                {0x1fe8, 0x1fe9, -8}, /*  2x Ῠ ..Ῡ  → ῠ ..ῡ  Greek2 */
-                {0x1fea, 0x1feb, -112}, /*  2x Ὺ ..Ύ  → ὺ ..ύ  Greek2 */
-                {0x1fec, 0x1fec, -7}, /*  1x Ῥ ..Ῥ  → ῥ ..ῥ  Greek2 */
-                {0x1ff8, 0x1ff9, -128}, /*  2x Ὸ ..Ό  → ὸ ..ό  Greek2 */
-                {0x1ffa, 0x1ffb, -126}, /*  2x Ὼ ..Ώ  → ὼ ..ώ  Greek2 */
-                {0x1ffc, 0x1ffc, -9}, /*  1x ῼ ..ῼ  → ῳ ..ῳ  Greek2 */
-                {0x2126, 0x2126, -7517}, /*  1x Ω ..Ω  → ω ..ω  Letterlike */
-                {0x212a, 0x212a, -8383}, /*  1x K ..K  → k ..k  Letterlike */
-                {0x212b, 0x212b, -8262}, /*  1x Å ..Å  → å ..å  Letterlike */
-                {0x2132, 0x2132, +28}, /*  1x Ⅎ ..Ⅎ  → ⅎ ..ⅎ  Letterlike */
-                {0x2160, 0x216f, +16}, /* 16x Ⅰ ..Ⅿ  → ⅰ ..ⅿ  Numbery */
-                {0x2183, 0x2183, +1}, /*  1x Ↄ ..Ↄ  → ↄ ..ↄ  Numbery */
-                {0x24b6, 0x24cf, +26}, /* 26x Ⓐ ..Ⓩ  → ⓐ ..ⓩ  Enclosed */
-                {0x2c00, 0x2c2e, +48}, /* 47x Ⰰ ..Ⱞ  → ⰰ ..ⱞ  Glagolitic */
-                {0xff21, 0xff3a, +32}, /* 26x Ａ..Ｚ → ａ..ｚ Dubs */
-            };
-            l = 0;
-            r = n = sizeof(kLower) / sizeof(kLower[0]);
-            while (l < r) {
-                m = (l + r) >> 1;
-                if (kLower[m].b < c) {
-                    l = m + 1;
-                } else {
-                    r = m;
-                }
-            }
-            if (l < n && kLower[l].a <= c && c <= kLower[l].b) {
-                return c + kLower[l].d;
-            } else {
-                return c;
-            }
-        }
-    } else {
-        static struct {
-            unsigned a;
-            unsigned b;
-            short d;
-        } kAstralLower[] = {
-            {0x10400, 0x10427, +40}, /* 40x 𐐀 ..𐐧  → 𐐨 ..𐑏  Deseret */
-            {0x104b0, 0x104d3, +40}, /* 36x 𐒰 ..𐓓  → 𐓘 ..𐓻  Osage */
-            {0x1d400, 0x1d419, +26}, /* 26x 𝐀 ..𝐙  → 𝐚 ..𝐳  Math */
-            {0x1d43c, 0x1d44d, +26}, /* 18x 𝐼 ..𝑍  → 𝑖 ..𝑧  Math */
-            {0x1d468, 0x1d481, +26}, /* 26x 𝑨 ..𝒁  → 𝒂 ..𝒛  Math */
-            {0x1d4ae, 0x1d4b5, +26}, /*  8x 𝒮 ..𝒵  → 𝓈 ..𝓏  Math */
-            {0x1d4d0, 0x1d4e9, +26}, /* 26x 𝓐 ..𝓩  → 𝓪 ..𝔃  Math */
-            {0x1d50d, 0x1d514, +26}, /*  8x 𝔍 ..𝔔  → 𝔧 ..𝔮  Math */
-            {0x1d56c, 0x1d585, +26}, /* 26x 𝕬 ..𝖅  → 𝖆 ..𝖟  Math */
-            {0x1d5a0, 0x1d5b9, +26}, /* 26x 𝖠 ..𝖹  → 𝖺 ..𝗓  Math */
-            {0x1d5d4, 0x1d5ed, +26}, /* 26x 𝗔 ..𝗭  → 𝗮 ..𝘇  Math */
-            {0x1d608, 0x1d621, +26}, /* 26x 𝘈 ..𝘡  → 𝘢 ..𝘻  Math */
-            {0x1d63c, 0x1d655, -442}, /* 26x 𝘼 ..𝙕  → 𝒂 ..𝒛  Math */
-            {0x1d670, 0x1d689, +26}, /* 26x 𝙰 ..𝚉  → 𝚊 ..𝚣  Math */
-            {0x1d6a8, 0x1d6b8, +26}, /* 17x 𝚨 ..𝚸  → 𝛂 ..𝛒  Math */
-            {0x1d6e2, 0x1d6f2, +26}, /* 17x 𝛢 ..𝛲  → 𝛼 ..𝜌  Math */
-            {0x1d71c, 0x1d72c, +26}, /* 17x 𝜜 ..𝜬  → 𝜶 ..𝝆  Math */
-            {0x1d756, 0x1d766, +26}, /* 17x 𝝖 ..𝝦  → 𝝰 ..𝞀  Math */
-            {0x1d790, 0x1d7a0, -90}, /* 17x 𝞐 ..𝞠  → 𝜶 ..𝝆  Math */
-        };
-        l = 0;
-        r = n = sizeof(kAstralLower) / sizeof(kAstralLower[0]);
-        while (l < r) {
-            m = (l + r) >> 1;
-            if (kAstralLower[m].b < c) {
-                l = m + 1;
-            } else {
-                r = m;
-            }
-        }
-        if (l < n && kAstralLower[l].a <= c && c <= kAstralLower[l].b) {
-            return c + kAstralLower[l].d;
-        } else {
-            return c;
-        }
     }
+    return (x = GetDelta(c, 0)) ? x : c;
 }
 
 unsigned bestlineUppercase(unsigned c) {
-    int m, l, r, n;
+    unsigned x;
     if (c < 0200) {
         if ('a' <= c && c <= 'z') {
             return c - 32;
         } else {
             return c;
         }
-    } else if (c <= 0xffff) {
-        if ((0x0101 <= c && c <= 0x0177) || /* 60x ā..ŵ → Ā..ā Watin-A */
-            (0x01df <= c && c <= 0x01ef) || /*  9x ǟ..ǯ → Ǟ..Ǯ Watin-B */
-            (0x01f8 <= c && c <= 0x021e) || /* 20x ǹ..ȟ → Ǹ..Ȟ Watin-B */
-            (0x0222 <= c && c <= 0x0232) || /*  9x ȣ..ȳ → Ȣ..Ȳ Watin-B */
-            (0x1e01 <= c && c <= 0x1eff)) { /*256x ḁ..ỿ → Ḁ..Ỿ Watin-C */
-            if (c == 0x0131)
-                return c + 232;
-            if (c == 0x1e9e)
-                return c;
-            return c - (c & 1);
-        } else if (0x01d0 <= c && c <= 0x01dc) {
-            return c - (~c & 1); /* 7x ǐ..ǜ → Ǐ..Ǜ Watin-B */
-        } else if (0xab70 <= c && c <= 0xabbf) {
-            return c - 38864; /* 80x ꭰ ..ꮿ  → Ꭰ ..Ꮿ  Cherokee Supplement */
-        } else {
-            static const struct {
-                unsigned short a;
-                unsigned short b;
-                short d;
-            } kUpper[] = {
-                {0x00b5, 0x00b5, +743}, /*  1x µ ..µ  → Μ ..Μ  Watin */
-                {0x00e0, 0x00f6, -32}, /* 23x à ..ö  → À ..Ö  Watin */
-                {0x00f8, 0x00fe, -32}, /*  7x ø ..þ  → Ø ..Þ  Watin */
-                {0x00ff, 0x00ff, +121}, /*  1x ÿ ..ÿ  → Ÿ ..Ÿ  Watin */
-                {0x017a, 0x017a, -1}, /*  1x ź ..ź  → Ź ..Ź  Watin-A */
-                {0x017c, 0x017c, -1}, /*  1x ż ..ż  → Ż ..Ż  Watin-A */
-                {0x017e, 0x017e, -1}, /*  1x ž ..ž  → Ž ..Ž  Watin-A */
-                {0x017f, 0x017f, -300}, /*  1x ſ ..ſ  → S ..S  Watin-A */
-                {0x0180, 0x0180, +195}, /*  1x ƀ ..ƀ  → Ƀ ..Ƀ  Watin-B */
-                {0x0183, 0x0183, -1}, /*  1x ƃ ..ƃ  → Ƃ ..Ƃ  Watin-B */
-                {0x0185, 0x0185, -1}, /*  1x ƅ ..ƅ  → Ƅ ..Ƅ  Watin-B */
-                {0x0188, 0x0188, -1}, /*  1x ƈ ..ƈ  → Ƈ ..Ƈ  Watin-B */
-                {0x018c, 0x018c, -1}, /*  1x ƌ ..ƌ  → Ƌ ..Ƌ  Watin-B */
-                {0x0192, 0x0192, -1}, /*  1x ƒ ..ƒ  → Ƒ ..Ƒ  Watin-B */
-                {0x0195, 0x0195, +97}, /*  1x ƕ ..ƕ  → Ƕ ..Ƕ  Watin-B */
-                {0x0199, 0x0199, -1}, /*  1x ƙ ..ƙ  → Ƙ ..Ƙ  Watin-B */
-                {0x019a, 0x019a, +163}, /*  1x ƚ ..ƚ  → Ƚ ..Ƚ  Watin-B */
-                {0x019e, 0x019e, +130}, /*  1x ƞ ..ƞ  → Ƞ ..Ƞ  Watin-B */
-                {0x01a1, 0x01a1, -1}, /*  1x ơ ..ơ  → Ơ ..Ơ  Watin-B */
-                {0x01a3, 0x01a3, -1}, /*  1x ƣ ..ƣ  → Ƣ ..Ƣ  Watin-B */
-                {0x01a5, 0x01a5, -1}, /*  1x ƥ ..ƥ  → Ƥ ..Ƥ  Watin-B */
-                {0x01a8, 0x01a8, -1}, /*  1x ƨ ..ƨ  → Ƨ ..Ƨ  Watin-B */
-                {0x01ad, 0x01ad, -1}, /*  1x ƭ ..ƭ  → Ƭ ..Ƭ  Watin-B */
-                {0x01b0, 0x01b0, -1}, /*  1x ư ..ư  → Ư ..Ư  Watin-B */
-                {0x01b4, 0x01b4, -1}, /*  1x ƴ ..ƴ  → Ƴ ..Ƴ  Watin-B */
-                {0x01b6, 0x01b6, -1}, /*  1x ƶ ..ƶ  → Ƶ ..Ƶ  Watin-B */
-                {0x01b9, 0x01b9, -1}, /*  1x ƹ ..ƹ  → Ƹ ..Ƹ  Watin-B */
-                {0x01bd, 0x01bd, -1}, /*  1x ƽ ..ƽ  → Ƽ ..Ƽ  Watin-B */
-                {0x01bf, 0x01bf, +56}, /*  1x ƿ ..ƿ  → Ƿ ..Ƿ  Watin-B */
-                {0x01c5, 0x01c5, -1}, /*  1x ǅ ..ǅ  → Ǆ ..Ǆ  Watin-B */
-                {0x01c6, 0x01c6, -2}, /*  1x ǆ ..ǆ  → Ǆ ..Ǆ  Watin-B */
-                {0x01c8, 0x01c8, -1}, /*  1x ǈ ..ǈ  → Ǉ ..Ǉ  Watin-B */
-                {0x01c9, 0x01c9, -2}, /*  1x ǉ ..ǉ  → Ǉ ..Ǉ  Watin-B */
-                {0x01cb, 0x01cb, -1}, /*  1x ǋ ..ǋ  → Ǌ ..Ǌ  Watin-B */
-                {0x01cc, 0x01cc, -2}, /*  1x ǌ ..ǌ  → Ǌ ..Ǌ  Watin-B */
-                {0x01ce, 0x01ce, -1}, /*  1x ǎ ..ǎ  → Ǎ ..Ǎ  Watin-B */
-                {0x01dd, 0x01dd, -79}, /*  1x ǝ ..ǝ  → Ǝ ..Ǝ  Watin-B */
-                {0x01f2, 0x01f2, -1}, /*  1x ǲ ..ǲ  → Ǳ ..Ǳ  Watin-B */
-                {0x01f3, 0x01f3, -2}, /*  1x ǳ ..ǳ  → Ǳ ..Ǳ  Watin-B */
-                {0x01f5, 0x01f5, -1}, /*  1x ǵ ..ǵ  → Ǵ ..Ǵ  Watin-B */
-                {0x023c, 0x023c, -1}, /*  1x ȼ ..ȼ  → Ȼ ..Ȼ  Watin-B */
-                {0x023f, 0x0240, +10815}, /*  2x ȿ ..ɀ  → Ȿ ..Ɀ  Watin-B */
-                {0x0242, 0x0242, -1}, /*  1x ɂ ..ɂ  → Ɂ ..Ɂ  Watin-B */
-                {0x0247, 0x0247, -1}, /*  1x ɇ ..ɇ  → Ɇ ..Ɇ  Watin-B */
-                {0x0249, 0x0249, -1}, /*  1x ɉ ..ɉ  → Ɉ ..Ɉ  Watin-B */
-                {0x024b, 0x024b, -1}, /*  1x ɋ ..ɋ  → Ɋ ..Ɋ  Watin-B */
-                {0x024d, 0x024d, -1}, /*  1x ɍ ..ɍ  → Ɍ ..Ɍ  Watin-B */
-                {0x024f, 0x024f, -1}, /*  1x ɏ ..ɏ  → Ɏ ..Ɏ  Watin-B */
-                {0x037b, 0x037d, +130}, /*  3x ͻ ..ͽ  → Ͻ ..Ͽ  Greek */
-                {0x03ac, 0x03ac, -38}, /*  1x ά ..ά  → Ά ..Ά  Greek */
-                {0x03ad, 0x03af, -37}, /*  3x έ ..ί  → Έ ..Ί  Greek */
-                {0x03b1, 0x03c1, -32}, /* 17x α ..ρ  → Α ..Ρ  Greek */
-                {0x03c2, 0x03c2, -31}, /*  1x ς ..ς  → Σ ..Σ  Greek */
-                {0x03c3, 0x03cb, -32}, /*  9x σ ..ϋ  → Σ ..Ϋ  Greek */
-                {0x03cc, 0x03cc, -64}, /*  1x ό ..ό  → Ό ..Ό  Greek */
-                {0x03cd, 0x03ce, -63}, /*  2x ύ ..ώ  → Ύ ..Ώ  Greek */
-                {0x03d0, 0x03d0, -62}, /*  1x ϐ ..ϐ  → Β ..Β  Greek */
-                {0x03d1, 0x03d1, -57}, /*  1x ϑ ..ϑ  → Θ ..Θ  Greek */
-                {0x03d5, 0x03d5, -47}, /*  1x ϕ ..ϕ  → Φ ..Φ  Greek */
-                {0x03d6, 0x03d6, -54}, /*  1x ϖ ..ϖ  → Π ..Π  Greek */
-                {0x03dd, 0x03dd, -1}, /*  1x ϝ ..ϝ  → Ϝ ..Ϝ  Greek */
-                {0x03f0, 0x03f0, -86}, /*  1x ϰ ..ϰ  → Κ ..Κ  Greek */
-                {0x03f1, 0x03f1, -80}, /*  1x ϱ ..ϱ  → Ρ ..Ρ  Greek */
-                {0x03f5, 0x03f5, -96}, /*  1x ϵ ..ϵ  → Ε ..Ε  Greek */
-                {0x0430, 0x044f, -32}, /* 32x а ..я  → А ..Я  Cyrillic */
-                {0x0450, 0x045f, -80}, /* 16x ѐ ..џ  → Ѐ ..Џ  Cyrillic */
-                {0x0461, 0x0461, -1}, /*  1x ѡ ..ѡ  → Ѡ ..Ѡ  Cyrillic */
-                {0x0463, 0x0463, -1}, /*  1x ѣ ..ѣ  → Ѣ ..Ѣ  Cyrillic */
-                {0x0465, 0x0465, -1}, /*  1x ѥ ..ѥ  → Ѥ ..Ѥ  Cyrillic */
-                {0x0473, 0x0473, -1}, /*  1x ѳ ..ѳ  → Ѳ ..Ѳ  Cyrillic */
-                {0x0491, 0x0491, -1}, /*  1x ґ ..ґ  → Ґ ..Ґ  Cyrillic */
-                {0x0499, 0x0499, -1}, /*  1x ҙ ..ҙ  → Ҙ ..Ҙ  Cyrillic */
-                {0x049b, 0x049b, -1}, /*  1x қ ..қ  → Қ ..Қ  Cyrillic */
-                {0x0561, 0x0586, -48}, /* 38x ա ..ֆ  → Ա ..Ֆ  Armenian */
-                {0x10d0, 0x10fa, +3008}, /* 43x ა ..ჺ  → Ა ..Ჺ  Georgian */
-                {0x10fd, 0x10ff, +3008}, /*  3x ჽ ..ჿ  → Ჽ ..Ჿ  Georgian */
-                {0x13f8, 0x13fd, -8}, /*  6x ᏸ ..ᏽ  → Ᏸ ..Ᏽ  Cherokee */
-                {0x214e, 0x214e, -28}, /*  1x ⅎ ..ⅎ  → Ⅎ ..Ⅎ  Letterlike */
-                {0x2170, 0x217f, -16}, /* 16x ⅰ ..ⅿ  → Ⅰ ..Ⅿ  Numbery */
-                {0x2184, 0x2184, -1}, /*  1x ↄ ..ↄ  → Ↄ ..Ↄ  Numbery */
-                {0x24d0, 0x24e9, -26}, /* 26x ⓐ ..ⓩ  → Ⓐ ..Ⓩ  Enclosed */
-                {0x2c30, 0x2c5e, -48}, /* 47x ⰰ ..ⱞ  → Ⰰ ..Ⱞ  Glagolitic */
-                {0x2d00, 0x2d25, -7264}, /* 38x ⴀ ..ⴥ  → Ⴀ ..Ⴥ  Georgian2 */
-                {0x2d27, 0x2d27, -7264}, /*  1x ⴧ ..ⴧ  → Ⴧ ..Ⴧ  Georgian2 */
-                {0x2d2d, 0x2d2d, -7264}, /*  1x ⴭ ..ⴭ  → Ⴭ ..Ⴭ  Georgian2 */
-                {0xff41, 0xff5a, -32}, /* 26x ａ..ｚ → Ａ..Ｚ Dubs */
-            };
-            l = 0;
-            r = n = sizeof(kUpper) / sizeof(kUpper[0]);
-            while (l < r) {
-                m = (l + r) >> 1;
-                if (kUpper[m].b < c) {
-                    l = m + 1;
-                } else {
-                    r = m;
-                }
-            }
-            if (l < n && kUpper[l].a <= c && c <= kUpper[l].b) {
-                return c + kUpper[l].d;
-            } else {
-                return c;
-            }
-        }
-    } else {
-        static const struct {
-            unsigned a;
-            unsigned b;
-            short d;
-        } kAstralUpper[] = {
-            {0x10428, 0x1044f, -40}, /* 40x 𐐨..𐑏 → 𐐀..𐐧 Deseret */
-            {0x104d8, 0x104fb, -40}, /* 36x 𐓘..𐓻 → 𐒰..𐓓 Osage */
-            {0x1d41a, 0x1d433, -26}, /* 26x 𝐚..𝐳 → 𝐀..𝐙 Math */
-            {0x1d456, 0x1d467, -26}, /* 18x 𝑖..𝑧 → 𝐼..𝑍 Math */
-            {0x1d482, 0x1d49b, -26}, /* 26x 𝒂..𝒛 → 𝑨..𝒁 Math */
-            {0x1d4c8, 0x1d4cf, -26}, /*  8x 𝓈..𝓏 → 𝒮..𝒵 Math */
-            {0x1d4ea, 0x1d503, -26}, /* 26x 𝓪..𝔃 → 𝓐..𝓩 Math */
-            {0x1d527, 0x1d52e, -26}, /*  8x 𝔧..𝔮 → 𝔍..𝔔 Math */
-            {0x1d586, 0x1d59f, -26}, /* 26x 𝖆..𝖟 → 𝕬..𝖅 Math */
-            {0x1d5ba, 0x1d5d3, -26}, /* 26x 𝖺..𝗓 → 𝖠..𝖹 Math */
-            {0x1d5ee, 0x1d607, -26}, /* 26x 𝗮..𝘇 → 𝗔..𝗭 Math */
-            {0x1d622, 0x1d63b, -26}, /* 26x 𝘢..𝘻 → 𝘈..𝘡 Math */
-            {0x1d68a, 0x1d6a3, +442}, /* 26x 𝒂..𝒛 → 𝘼..𝙕 Math */
-            {0x1d6c2, 0x1d6d2, -26}, /* 26x 𝚊..𝚣 → 𝙰..𝚉 Math */
-            {0x1d6fc, 0x1d70c, -26}, /* 17x 𝛂..𝛒 → 𝚨..𝚸 Math */
-            {0x1d736, 0x1d746, -26}, /* 17x 𝛼..𝜌 → 𝛢..𝛲 Math */
-            {0x1d770, 0x1d780, -26}, /* 17x 𝜶..𝝆 → 𝜜..𝜬 Math */
-            {0x1d770, 0x1d756, -26}, /* 17x 𝝰..𝞀 → 𝝖..𝝦 Math */
-            {0x1d736, 0x1d790, -90}, /* 17x 𝜶..𝝆 → 𝞐..𝞠 Math */
-        };
-        l = 0;
-        r = n = sizeof(kAstralUpper) / sizeof(kAstralUpper[0]);
-        while (l < r) {
-            m = (l + r) >> 1;
-            if (kAstralUpper[m].b < c) {
-                l = m + 1;
-            } else {
-                r = m;
-            }
-        }
-        if (l < n && kAstralUpper[l].a <= c && c <= kAstralUpper[l].b) {
-            return c + kAstralUpper[l].d;
+    }
+    return (x = GetDelta(c, 1)) ? x : c;
+}
+
+/**
+ * Returns simple case folding of 𝑐.
+ *
+ * Unlike bestlineLowercase() this sends every member of a case class,
+ * e.g. Σσς or Kk and the Kelvin sign, to the same codepoint.
+ */
+static unsigned FoldCase(unsigned c) {
+    unsigned x;
+    if (c < 0200) {
+        if ('A' <= c && c <= 'Z') {
+            return c + 32;
         } else {
             return c;
         }
     }
+    return (x = GetDelta(c, 4)) ? x : c;
 }
 
 char bestlineNotSeparator(unsigned c) {
     return !bestlineIsSeparator(c);
 }
 
-static unsigned GetMirror(const unsigned short A[][2], size_t n, unsigned c) {
-    int l, m, r;
-    l = 0;
-    r = n - 1;
-    while (l <= r) {
-        m = (l + r) >> 1;
-        if (A[m][0] < c) {
-            l = m + 1;
-        } else if (A[m][0] > c) {
-            r = m - 1;
-        } else {
-            return A[m][1];
-        }
-    }
-    return 0;
-}
-
 unsigned bestlineMirrorLeft(unsigned c) {
-    static const unsigned short kMirrorRight[][2] = {
-        {L')', L'('},   {L']', L'['},   {L'}', L'{'},   {L'⁆', L'⁅'},   {L'⁾', L'⁽'},
-        {L'₎', L'₍'},   {L'⌉', L'⌈'},   {L'⌋', L'⌊'},   {L'〉', L'〈'}, {L'❩', L'❨'},
-        {L'❫', L'❪'},   {L'❭', L'❬'},   {L'❯', L'❮'},   {L'❱', L'❰'},   {L'❳', L'❲'},
-        {L'❵', L'❴'},   {L'⟆', L'⟅'},   {L'⟧', L'⟦'},   {L'⟩', L'⟨'},   {L'⟫', L'⟪'},
-        {L'⟭', L'⟬'},   {L'⟯', L'⟮'},   {L'⦄', L'⦃'},   {L'⦆', L'⦅'},   {L'⦈', L'⦇'},
-        {L'⦊', L'⦉'},   {L'⦌', L'⦋'},   {L'⦎', L'⦏'},   {L'⦐', L'⦍'},   {L'⦒', L'⦑'},
-        {L'⦔', L'⦓'},   {L'⦘', L'⦗'},   {L'⧙', L'⧘'},   {L'⧛', L'⧚'},   {L'⧽', L'⧼'},
-        {L'﹚', L'﹙'}, {L'﹜', L'﹛'}, {L'﹞', L'﹝'}, {L'）', L'（'}, {L'］', L'［'},
-        {L'｝', L'｛'}, {L'｣', L'｢'},
-    };
-    return GetMirror(kMirrorRight, sizeof(kMirrorRight) / sizeof(kMirrorRight[0]), c);
+    return GetDelta(c, 2);
 }
 
 unsigned bestlineMirrorRight(unsigned c) {
-    static const unsigned short kMirrorLeft[][2] = {
-        {L'(', L')'},   {L'[', L']'},   {L'{', L'}'},   {L'⁅', L'⁆'},   {L'⁽', L'⁾'},
-        {L'₍', L'₎'},   {L'⌈', L'⌉'},   {L'⌊', L'⌋'},   {L'〈', L'〉'}, {L'❨', L'❩'},
-        {L'❪', L'❫'},   {L'❬', L'❭'},   {L'❮', L'❯'},   {L'❰', L'❱'},   {L'❲', L'❳'},
-        {L'❴', L'❵'},   {L'⟅', L'⟆'},   {L'⟦', L'⟧'},   {L'⟨', L'⟩'},   {L'⟪', L'⟫'},
-        {L'⟬', L'⟭'},   {L'⟮', L'⟯'},   {L'⦃', L'⦄'},   {L'⦅', L'⦆'},   {L'⦇', L'⦈'},
-        {L'⦉', L'⦊'},   {L'⦋', L'⦌'},   {L'⦍', L'⦐'},   {L'⦏', L'⦎'},   {L'⦑', L'⦒'},
-        {L'⦓', L'⦔'},   {L'⦗', L'⦘'},   {L'⧘', L'⧙'},   {L'⧚', L'⧛'},   {L'⧼', L'⧽'},
-        {L'﹙', L'﹚'}, {L'﹛', L'﹜'}, {L'﹝', L'﹞'}, {L'（', L'）'}, {L'［', L'］'},
-        {L'｛', L'｝'}, {L'｢', L'｣'},
-    };
-    return GetMirror(kMirrorLeft, sizeof(kMirrorLeft) / sizeof(kMirrorLeft[0]), c);
+    return GetDelta(c, 3);
+}
+
+#define G(x) (1u << kGrapheme##x)
+#define GEXT (G(Extend) | G(ZWJ) | G(SpacingMark))
+
+/*
+ * Grapheme cluster rules GB3 through GB9b from UAX #29, where bit 𝑏 of
+ * kGraphemeJoin[𝑎] is set if there's no boundary between classes 𝑎 and
+ * 𝑏. The pictographic and regional indicator rules need more context
+ * so they're applied by bestlineGraphemeBreak().
+ */
+static const unsigned short kGraphemeJoin[15] = {
+    GEXT,                                                /* Other */
+    G(LF),                                               /* CR */
+    0,                                                   /* LF */
+    0,                                                   /* Control */
+    GEXT,                                                /* Extend */
+    GEXT,                                                /* ZWJ */
+    GEXT,                                                /* RegionalIndicator */
+    ~(G(CR) | G(LF) | G(Control)) & 0x7fff,              /* Prepend */
+    GEXT,                                                /* SpacingMark */
+    G(L) | G(V) | G(LV) | G(LVT) | GEXT,                 /* L */
+    G(V) | G(T) | GEXT,                                  /* V */
+    G(T) | GEXT,                                         /* T */
+    G(V) | G(T) | GEXT,                                  /* LV */
+    G(T) | GEXT,                                         /* LVT */
+    GEXT,                                                /* Pictographic */
+};
+
+#undef GEXT
+#undef G
+
+static unsigned GetGrapheme(unsigned c) {
+    unsigned b;
+    if (c >= 0x110000)
+        return kGraphemeOther;
+    b = kGraphemeStage3[kGraphemeStage2[kGraphemeStage1[c >> 12]][c >> 6 & 63]][c >> 1 & 31];
+    return b >> ((c & 1) * 4) & 15;
+}
+
+/**
+ * Returns nonzero if a grapheme cluster boundary comes before 𝑐.
+ *
+ * The caller feeds each codepoint of the text through this function in
+ * order. The state word must be zero at the start of the text, or at a
+ * known cluster boundary. It remembers the previous class, whether we
+ * are inside an emoji zwj sequence (GB11) and the parity of the current
+ * run of regional indicators (GB12, GB13).
+ */
+static char bestlineGraphemeBreak(unsigned *state, unsigned c) {
+    char brk;
+    unsigned a, b, e, ri;
+    b = GetGrapheme(c);
+    e = *state >> 4 & 3;
+    ri = *state >> 6 & 1;
+    if (!*state) {
+        brk = 1;
+    } else {
+        a = (*state & 15) - 1;
+        brk = !(kGraphemeJoin[a] >> b & 1);
+        if (b == kGraphemePictographic && e == 2)
+            brk = 0;
+        if (a == kGraphemeRegionalIndicator && b == a && ri)
+            brk = 0;
+    }
+    if (b == kGraphemePictographic) {
+        e = 1;
+    } else if (e == 1 && b == kGraphemeZWJ) {
+        e = 2;
+    } else if (e != 1 || b != kGraphemeExtend) {
+        e = 0;
+    }
+    ri = b == kGraphemeRegionalIndicator ? ri ^ 1 : 0;
+    *state = (b + 1) | e << 4 | ri << 6;
+    return brk;
 }
 
 static char StartsWith(const char *s, const char *prefix) {
@@ -1429,6 +2158,17 @@ static inline int Bsr(unsigned long long x) {
 #endif
 }
 
+static inline int Bsf(unsigned x) {
+#if defined(__GNUC__) && !defined(__STRICT_ANSI__)
+    return __builtin_ctz(x);
+#else
+    int b;
+    for (b = 0; !(x & 1); ++b)
+        x >>= 1;
+    return b;
+#endif
+}
+
 static struct rune DecodeUtf8(int c) {
     struct rune r;
     if (c < 252) {
@@ -1465,17 +2205,198 @@ static unsigned long long EncodeUtf8(unsigned c) {
     return c | w | e >> 8;
 }
 
+/**
+ * Decodes rune at p, which must be well-formed.
+ *
+ * Everything we decode has either been framed by the UTF-8 state
+ * machine in bestlineReadCharacter() or repaired by RepairUtf8() on
+ * its way into the line buffer, so the lead byte gives the length.
+ */
 static struct rune GetUtf8(const char *p, size_t n) {
+    size_t k;
     struct rune r;
     if ((r.n = r.c = 0) < n && (r.c = p[r.n++] & 255) >= 0300) {
-        r.c = DecodeUtf8(r.c).c;
-        while (r.n < n && (p[r.n] & 0300) == 0200) {
+        r = DecodeUtf8(r.c);
+        for (k = Min((size_t)r.n, n - 1), r.n = 1; k; --k) {
             r.c = r.c << 6 | (p[r.n++] & 077);
         }
     }
     return r;
 }
 
+/**
+ * Returns length of well-formed UTF-8 sequence at p.
+ *
+ * If the sequence is ill-formed then the negated length of its maximal
+ * subpart is returned, which is how many bytes Unicode §3.9 says should
+ * be substituted by a single U+FFFD. Surrogates, overlong encodings and
+ * anything past U+10FFFF are rejected.
+ */
+static int ScanUtf8(const char *p, size_t n) {
+    int c, i, k, lo, hi;
+    if ((c = p[0] & 255) < 0x80)
+        return 1;
+    lo = 0x80;
+    hi = 0xbf;
+    if (0xc2 <= c && c <= 0xdf) {
+        k = 2;
+    } else if (0xe0 <= c && c <= 0xef) {
+        k = 3;
+        if (c == 0xe0)
+            lo = 0xa0;
+        if (c == 0xed)
+            hi = 0x9f;
+    } else if (0xf0 <= c && c <= 0xf4) {
+        k = 4;
+        if (c == 0xf0)
+            lo = 0x90;
+        if (c == 0xf4)
+            hi = 0x8f;
+    } else {
+        return -1;
+    }
+    for (i = 1; i < k; ++i, lo = 0x80, hi = 0xbf) {
+        if ((size_t)i == n || (c = p[i] & 255) < lo || c > hi) {
+            return -i;
+        }
+    }
+    return k;
+}
+
+/**
+ * Returns length of longest prefix of p that's well-formed UTF-8.
+ *
+ * On SSSE3 we use the Keiser-Lemire algorithm, which looks up the high
+ * and low nibbles of each byte pair in three shuffle tables and checks
+ * sixteen bytes at a time. Elsewhere runs of ASCII are skipped a word
+ * at a time. In both cases ScanUtf8() has the final word, so we always
+ * stop exactly where the first ill-formed sequence begins.
+ */
+static size_t SkipUtf8(const char *p, size_t n) {
+    int k;
+    size_t i = 0;
+#if defined(__SSSE3__)
+    enum {
+        kTooShort = 1,
+        kTooLong = 2,
+        kOverlong3 = 4,
+        kTooLarge = 8,
+        kSurrogate = 16,
+        kOverlong2 = 32,
+        kTooLarge1000 = 64,
+        kOverlong4 = 64,
+        kTwoConts = 128,
+        kCarry = kTooShort | kTooLong | kTwoConts,
+    };
+    if (n >= 16) {
+        int c;
+        __m128i v, w, e, b1, b2, b3, nib = _mm_set1_epi8(15);
+        const __m128i kByte1High = _mm_setr_epi8(
+            kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong,
+            kTwoConts, kTwoConts, kTwoConts, kTwoConts, kTooShort | kOverlong2, kTooShort,
+            kTooShort | kOverlong3 | kSurrogate,
+            kTooShort | kTooLarge | kTooLarge1000 | kOverlong4);
+        const __m128i kByte1Low = _mm_setr_epi8(
+            kCarry | kOverlong3 | kOverlong2 | kOverlong4, kCarry | kOverlong2, kCarry, kCarry,
+            kCarry | kTooLarge, kCarry | kTooLarge | kTooLarge1000,
+            kCarry | kTooLarge | kTooLarge1000, kCarry | kTooLarge | kTooLarge1000,
+            kCarry | kTooLarge | kTooLarge1000, kCarry | kTooLarge | kTooLarge1000,
+            kCarry | kTooLarge | kTooLarge1000, kCarry | kTooLarge | kTooLarge1000,
+            kCarry | kTooLarge | kTooLarge1000, kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+            kCarry | kTooLarge | kTooLarge1000, kCarry | kTooLarge | kTooLarge1000);
+        const __m128i kByte2High = _mm_setr_epi8(
+            kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort,
+            kTooShort,
+            kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 | kOverlong4,
+            kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+            kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+            kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge, kTooShort, kTooShort,
+            kTooShort, kTooShort);
+        for (w = _mm_setzero_si128(); i + 16 <= n; i += 16, w = v) {
+            v = _mm_loadu_si128((const __m128i *)(p + i));
+            if (!_mm_movemask_epi8(_mm_or_si128(v, w)))
+                continue;
+            b1 = _mm_alignr_epi8(v, w, 15);
+            b2 = _mm_alignr_epi8(v, w, 14);
+            b3 = _mm_alignr_epi8(v, w, 13);
+            e = _mm_and_si128(
+                _mm_and_si128(
+                    _mm_shuffle_epi8(kByte1High, _mm_and_si128(_mm_srli_epi16(b1, 4), nib)),
+                    _mm_shuffle_epi8(kByte1Low, _mm_and_si128(b1, nib))),
+                _mm_shuffle_epi8(kByte2High, _mm_and_si128(_mm_srli_epi16(v, 4), nib)));
+            e = _mm_xor_si128(e, _mm_and_si128(_mm_or_si128(_mm_subs_epu8(b2, _mm_set1_epi8(0x60)),
+                                                            _mm_subs_epu8(b3, _mm_set1_epi8(0x70))),
+                                               _mm_set1_epi8(-128)));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(e, _mm_setzero_si128())) != 0xffff)
+                break;
+        }
+        /* back up to the last lead byte since it may be incomplete */
+        for (k = 1; k <= 3 && (size_t)k <= i; ++k) {
+            if ((c = p[i - k] & 255) < 0200)
+                break;
+            if (c >= 0300) {
+                i -= k;
+                break;
+            }
+        }
+    }
+#endif
+    while (i < n) {
+        for (; i + 8 <= n; i += 8) {
+            unsigned long long x;
+            memcpy(&x, p + i, 8);
+            if (x & 0x8080808080808080)
+                break;
+        }
+        if (i == n || (k = ScanUtf8(p + i, n - i)) < 0)
+            break;
+        i += k;
+    }
+    return i;
+}
+
+/**
+ * Copies UTF-8 to d substituting U+FFFD for ill-formed sequences.
+ *
+ * This is a single pass over the input; well-formed runs are copied
+ * wholesale. The destination must have room for n*3 bytes.
+ *
+ * @return number of bytes written to d
+ */
+static size_t RepairUtf8(char *d, const char *p, size_t n) {
+    size_t i, j, k;
+    for (i = j = 0; i < n;) {
+        k = SkipUtf8(p + i, n - i);
+        memcpy(d + j, p + i, k);
+        i += k;
+        j += k;
+        if (i < n) {
+            i += -ScanUtf8(p + i, n - i);
+            memcpy(d + j, "\357\277\275", 3);
+            j += 3;
+        }
+    }
+    return j;
+}
+
+/**
+ * Returns malloc()'d copy of p with its UTF-8 repaired.
+ *
+ * @param n is byte length of p on input and copy on output
+ * @return NUL-terminated copy, or NULL if out of memory
+ */
+static char *CopyUtf8(const char *p, size_t *n) {
+    char *s;
+    size_t m;
+    m = SkipUtf8(p, *n);
+    if (!(s = (char *)malloc(m + (*n - m) * 3 + 1)))
+        return 0;
+    memcpy(s, p, m);
+    *n = m + RepairUtf8(s + m, p + m, *n - m);
+    s[*n] = 0;
+    return s;
+}
+
 static char *FormatUnsigned(char *p, unsigned x) {
     char t;
     size_t i, a, b;
@@ -1502,6 +2423,15 @@ static void abInit(struct abuf *a) {
     a->b[0] = 0;
 }
 
+static void abClear(struct abuf *a) {
+    if (a->b) {
+        a->len = 0;
+        a->b[0] = 0;
+    } else {
+        abInit(a);
+    }
+}
+
 static char abGrow(struct abuf *a, int need) {
     int cap;
     char *b;
@@ -1580,10 +2510,95 @@ static int WaitUntilReady(int fd, int events) {
     return _MyPoll(fd, events, -1);
 }
 
+/**
+ * Returns read-ahead buffer holding bytes from 𝑓𝑑, or else an empty
+ * one that can be used for it, or null if they're all in use.
+ *
+ * When four other descriptors have bytes buffered, 𝑓𝑑 gets read one
+ * byte at a time until one of them is drained.
+ */
+static struct bestlineReadAhead *GetReadAhead(int fd) {
+    unsigned i;
+    struct bestlineReadAhead *empty = 0;
+    for (i = 0; i < sizeof(inbufs) / sizeof(*inbufs); ++i) {
+        if (inbufs[i].i < inbufs[i].n) {
+            if (inbufs[i].fd == fd)
+                return inbufs + i;
+        } else if (!empty) {
+            empty = inbufs + i;
+        }
+    }
+    return empty;
+}
+
 static char HasPendingInput(int fd) {
+    struct bestlineReadAhead *r;
+    if ((r = GetReadAhead(fd)) && r->i < r->n)
+        return 1;
     return _MyPoll(fd, POLLIN, 0) == 1;
 }
 
+/**
+ * Fills read-ahead buffer of 𝑓𝑑, which must be empty.
+ *
+ * Keystrokes trickle in one at a time, but a paste can be thousands of
+ * bytes, which this takes in with a single read, even if the read was
+ * overridden by bestlineUserIO(). Only what FIONREAD says is already
+ * waiting gets read, so waiting for a keystroke reads a single byte,
+ * and the buffer is only as big as the largest burst it has held.
+ */
+static int FillReadAhead(struct bestlineReadAhead *r, int fd) {
+    int rc, avail;
+    unsigned n;
+    char *p;
+    if (ioctl(fd, FIONREAD, &avail) == -1 || avail < 1)
+        avail = 1;
+    n = Min((unsigned)avail, BESTLINE_MAX_READAHEAD);
+    if (n > r->cap) {
+        if ((p = (char *)realloc(r->b, n))) {
+            r->b = p;
+            r->cap = n;
+        } else if (!r->cap) {
+            return -1;
+        } else {
+            n = r->cap;
+        }
+    }
+    if ((rc = _MyRead(fd, r->b, n)) > 0) {
+        r->fd = fd;
+        r->i = 0;
+        r->n = rc;
+    }
+    return rc;
+}
+
+static int ReadByte(int fd, unsigned char *c) {
+    int rc;
+    struct bestlineReadAhead *r;
+    if (!(r = GetReadAhead(fd)))
+        return _MyRead(fd, c, 1);
+    if (r->i == r->n && (rc = FillReadAhead(r, fd)) <= 0)
+        return rc;
+    *c = r->b[r->i++];
+    return 1;
+}
+
+/**
+ * Returns true if a keystroke just read from 𝑓𝑑 came with so many
+ * bytes behind it, that it's likely the start of a paste.
+ */
+static char IsPasteBurst(int fd) {
+    struct bestlineReadAhead *r;
+    return BESTLINE_PASTE_BURST && (r = GetReadAhead(fd)) &&
+           r->n - r->i >= BESTLINE_PASTE_BURST;
+}
+
+static unsigned long long GetMicros(void) {
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+    return (unsigned long long)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
 static char *GetLineBlock(FILE *f) {
     ssize_t rc;
     char *p = 0;
@@ -1603,20 +2618,107 @@ static char *GetLineBlock(FILE *f) {
     }
 }
 
-long bestlineReadCharacter(int fd, char *p, unsigned long n) {
+/**
+ * Returns key for final byte of CSI or SS3 sequence, or -1u if none.
+ */
+static unsigned GetFinalKey(int c) {
+    switch (c) {
+    case 'A':
+        return BESTLINE_KEY_UP;
+    case 'B':
+        return BESTLINE_KEY_DOWN;
+    case 'C':
+        return BESTLINE_KEY_RIGHT;
+    case 'D':
+        return BESTLINE_KEY_LEFT;
+    case 'H':
+        return BESTLINE_KEY_HOME;
+    case 'F':
+        return BESTLINE_KEY_END;
+    case 'P':
+    case 'Q':
+    case 'R':
+    case 'S':
+        return BESTLINE_KEY_F1 + (c - 'P');
+    default:
+        return -1u;
+    }
+}
+
+/**
+ * Returns key for parameter of \e[𝑛~ sequence, or -1u if none.
+ */
+static unsigned GetTildeKey(unsigned n) {
+    static const unsigned char kTilde[] = {
+        0, /* 0 */
+        BESTLINE_KEY_HOME - BESTLINE_KEY_UP, /* 1 */
+        BESTLINE_KEY_INSERT - BESTLINE_KEY_UP, /* 2 */
+        BESTLINE_KEY_DELETE - BESTLINE_KEY_UP, /* 3 */
+        BESTLINE_KEY_END - BESTLINE_KEY_UP, /* 4 */
+        BESTLINE_KEY_PAGEUP - BESTLINE_KEY_UP, /* 5 */
+        BESTLINE_KEY_PAGEDOWN - BESTLINE_KEY_UP, /* 6 */
+        BESTLINE_KEY_HOME - BESTLINE_KEY_UP, /* 7 */
+        BESTLINE_KEY_END - BESTLINE_KEY_UP, /* 8 */
+        0, 0, /* 9-10 */
+        BESTLINE_KEY_F1 - BESTLINE_KEY_UP, /* 11 */
+        BESTLINE_KEY_F2 - BESTLINE_KEY_UP, /* 12 */
+        BESTLINE_KEY_F3 - BESTLINE_KEY_UP, /* 13 */
+        BESTLINE_KEY_F4 - BESTLINE_KEY_UP, /* 14 */
+        BESTLINE_KEY_F5 - BESTLINE_KEY_UP, /* 15 */
+        0, /* 16 */
+        BESTLINE_KEY_F6 - BESTLINE_KEY_UP, /* 17 */
+        BESTLINE_KEY_F7 - BESTLINE_KEY_UP, /* 18 */
+        BESTLINE_KEY_F8 - BESTLINE_KEY_UP, /* 19 */
+        BESTLINE_KEY_F9 - BESTLINE_KEY_UP, /* 20 */
+        BESTLINE_KEY_F10 - BESTLINE_KEY_UP, /* 21 */
+        0, /* 22 */
+        BESTLINE_KEY_F11 - BESTLINE_KEY_UP, /* 23 */
+        BESTLINE_KEY_F12 - BESTLINE_KEY_UP, /* 24 */
+    };
+    if (n == 200)
+        return BESTLINE_KEY_PASTE;
+    if (n == 201)
+        return BESTLINE_KEY_PASTE_END;
+    if (n < sizeof(kTilde) && kTilde[n])
+        return BESTLINE_KEY_UP + (unsigned)kTilde[n];
+    return -1u;
+}
+
+/**
+ * Reads keystroke from 𝑓𝑑 and decodes it.
+ *
+ * This is a state machine that consumes exactly one keystroke, which
+ * may be a utf-8 sequence, or an ansi escape sequence of any length,
+ * e.g. \e[1;5C for ctrl-right, or an osc string. The raw bytes are
+ * stored to 𝑝 (truncated to 𝑛-1 bytes and nul terminated) and what
+ * they mean is stored to 𝑘, so nothing needs to parse them again.
+ *
+ * @return number of bytes read, 0 on eof, or -1 w/ errno
+ */
+static long bestlineDecode(int fd, char *p, unsigned long n, struct bestlineKey *k) {
     int e;
     size_t i;
     ssize_t rc;
     struct rune r;
     unsigned char c;
+    unsigned long long w;
+    unsigned par[2], np;
+    char alt, priv, lfk;
+    unsigned char intro;
     enum { kAscii, kUtf8, kEsc, kCsi1, kCsi2, kSs, kNf, kStr, kStr2, kDone } t;
     i = 0;
     r.c = 0;
     r.n = 0;
     e = errno;
     t = kAscii;
+    alt = priv = lfk = 0;
+    c = intro = 0;
+    np = par[0] = par[1] = 0;
     if (n)
         p[0] = 0;
+    k->key = BESTLINE_KEY_UNKNOWN;
+    k->mods = 0;
+    k->text[0] = 0;
     do {
         for (;;) {
             if (gotint) {
@@ -1624,7 +2726,7 @@ long bestlineReadCharacter(int fd, char *p, unsigned long n) {
                 return -1;
             }
             if (n) {
-                rc = _MyRead(fd, &c, 1);
+                rc = ReadByte(fd, &c);
             } else {
                 rc = _MyRead(fd, 0, 0);
             }
@@ -1669,6 +2771,8 @@ long bestlineReadCharacter(int fd, char *p, unsigned long n) {
                 p[0] = c;
             t = kAscii;
             i = 1;
+            alt = priv = lfk = 0;
+            np = par[0] = par[1] = 0;
             /* fallthrough */
         case kAscii:
             if (c < 0200) {
@@ -1676,6 +2780,7 @@ long bestlineReadCharacter(int fd, char *p, unsigned long n) {
                     t = kEsc;
                 } else {
                     t = kDone;
+                    k->key = c;
                 }
             } else if (c >= 0300) {
                 t = kUtf8;
@@ -1698,6 +2803,7 @@ long bestlineReadCharacter(int fd, char *p, unsigned long n) {
                         break;
                     case 0x8e: /* SS2 (Single Shift Two) */
                     case 0x8f: /* SS3 (Single Shift Three) */
+                        intro = r.c == 0x8f ? 'O' : 'N';
                         t = kSs;
                         break;
                     case 0x90: /* DCS (Device Control String) */
@@ -1709,6 +2815,7 @@ long bestlineReadCharacter(int fd, char *p, unsigned long n) {
                         break;
                     default:
                         t = kDone;
+                        k->key = r.c;
                         break;
                     }
                 }
@@ -1727,9 +2834,13 @@ long bestlineReadCharacter(int fd, char *p, unsigned long n) {
                     t = kNf;
                 } else {
                     t = kDone;
+                    k->key = c;
+                    k->mods = BESTLINE_MOD_ALT;
                 }
             } else if (0x30 <= c && c <= 0x3f) { /* Fp */
                 t = kDone;
+                k->key = c;
+                k->mods = BESTLINE_MOD_ALT;
             } else if (0x20 <= c && c <= 0x5F) { /* Fe */
                 switch (c) {
                 case '[':
@@ -1737,6 +2848,7 @@ long bestlineReadCharacter(int fd, char *p, unsigned long n) {
                     break;
                 case 'N': /* SS2 (Single Shift Two) */
                 case 'O': /* SS3 (Single Shift Three) */
+                    intro = c;
                     t = kSs;
                     break;
                 case 'P': /* DCS (Device Control String) */
@@ -1748,23 +2860,32 @@ long bestlineReadCharacter(int fd, char *p, unsigned long n) {
                     break;
                 default:
                     t = kDone;
+                    k->key = c;
+                    k->mods = BESTLINE_MOD_ALT;
                     break;
                 }
             } else if (0x60 <= c && c <= 0x7e) { /* Fs */
                 t = kDone;
+                k->key = c;
+                k->mods = BESTLINE_MOD_ALT;
             } else if (c == 033) {
                 if (i < 3) {
-                    /* alt chording */
+                    alt = 1; /* alt chording */
                 } else {
                     t = kDone; /* esc mashing */
+                    k->key = 033;
                     i = 1;
                 }
             } else {
                 t = kDone;
+                k->key = c < 0200 ? (unsigned)c : (unsigned)BESTLINE_KEY_UNKNOWN;
+                k->mods = BESTLINE_MOD_ALT;
             }
             break;
         case kSs:
             t = kDone;
+            if (intro == 'O')
+                k->key = GetFinalKey(c);
             break;
         case kNf:
             if (0x30 <= c && c <= 0x7e) {
@@ -1776,11 +2897,34 @@ long bestlineReadCharacter(int fd, char *p, unsigned long n) {
         case kCsi1:
             if (0x20 <= c && c <= 0x2f) {
                 t = kCsi2;
+                priv = 1;
             } else if (c == '[' && ((i == 3) || (i == 4 && p[1] == 033))) {
-                /* linux function keys */
+                lfk = 1; /* linux function keys */
             } else if (0x40 <= c && c <= 0x7e) {
                 t = kDone;
-            } else if (!(0x30 <= c && c <= 0x3f)) {
+                if (priv) {
+                    /* private or unknown sequence */
+                } else if (lfk) {
+                    if ('A' <= c && c <= 'E')
+                        k->key = BESTLINE_KEY_F1 + (c - 'A');
+                } else if (c == '~') {
+                    k->key = GetTildeKey(par[0]);
+                } else if (c == 'Z') {
+                    k->key = '\t';
+                    k->mods = BESTLINE_MOD_SHIFT;
+                } else if (np || !par[0] || par[0] == 1) {
+                    k->key = GetFinalKey(c);
+                }
+                if (!priv && np && par[1] > 1)
+                    k->mods |= (par[1] - 1) & (BESTLINE_MOD_SHIFT | BESTLINE_MOD_ALT | BESTLINE_MOD_CTRL);
+            } else if ('0' <= c && c <= '9') {
+                if (np < 2)
+                    par[np] = Min(par[np] * 10 + (c - '0'), 9999);
+            } else if (c == ';') {
+                ++np;
+            } else if (0x3a <= c && c <= 0x3f) {
+                priv = 1; /* e.g. \e[?2026;2$y */
+            } else {
                 goto Whoopsie;
             }
             break;
@@ -1820,10 +2964,42 @@ long bestlineReadCharacter(int fd, char *p, unsigned long n) {
             assert(0);
         }
     } while (t != kDone);
+    if (k->key == -1u)
+        k->key = BESTLINE_KEY_UNKNOWN;
+    if (alt && k->key != BESTLINE_KEY_UNKNOWN)
+        k->mods |= BESTLINE_MOD_ALT;
+    if (k->key < BESTLINE_KEY_UP) {
+        w = EncodeUtf8(k->key);
+        np = 0;
+        do
+            k->text[np++] = w;
+        while ((w >>= 8));
+        k->text[np] = 0;
+    }
     errno = e;
     return i;
 }
 
+long bestlineReadCharacter(int fd, char *p, unsigned long n) {
+    struct bestlineKey k;
+    return bestlineDecode(fd, p, n, &k);
+}
+
+/**
+ * Reads keystroke from terminal.
+ *
+ * Unlike bestlineReadCharacter(), this says what the bytes mean, so
+ * escape sequences of any length, e.g. \e[1;5C, come back as one key
+ * with modifiers, e.g. BESTLINE_KEY_RIGHT with BESTLINE_MOD_CTRL. The
+ * terminal should already be in raw mode.
+ *
+ * @return number of bytes read, 0 on eof, or -1 w/ errno
+ */
+long bestlineReadKey(int fd, bestlineKey *k) {
+    char b[16];
+    return bestlineDecode(fd, b, sizeof(b), k);
+}
+
 static char *GetLineChar(int fin, int fout) {
     size_t got;
     ssize_t rc;
@@ -1919,20 +3095,121 @@ static char *Copy(char *d, const char *s, size_t n) {
     return d + n;
 }
 
-static int CompareStrings(const char *a, const char *b) {
-    size_t i;
-    int x, y, c;
-    for (i = 0;; ++i) {
-        x = bestlineLowercase(a[i] & 255);
-        y = bestlineLowercase(b[i] & 255);
-        if ((c = x - y) || !x) {
-            return c;
+/**
+ * Returns length of longest common prefix of ASCII bytes in 𝑎 and 𝑏
+ * after folding A-Z to a-z, stopping early at any non-ASCII byte.
+ */
+static size_t MatchAsciiFolded(const char *a, const char *b, size_t n) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    {
+        unsigned m;
+        __m128i x, y, az, off, bit;
+        az = _mm_set1_epi8(-128 + 26);
+        off = _mm_set1_epi8(128 - 'A');
+        bit = _mm_set1_epi8(040);
+        for (; i + 16 <= n; i += 16) {
+            x = _mm_loadu_si128((const __m128i *)(a + i));
+            y = _mm_loadu_si128((const __m128i *)(b + i));
+            x = _mm_or_si128(x, _mm_and_si128(bit, _mm_cmplt_epi8(_mm_add_epi8(x, off), az)));
+            y = _mm_or_si128(y, _mm_and_si128(bit, _mm_cmplt_epi8(_mm_add_epi8(y, off), az)));
+            m = _mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) & ~_mm_movemask_epi8(_mm_or_si128(x, y));
+            if (m != 0xffff)
+                break;
         }
     }
+#endif
+    for (; i + 8 <= n; i += 8) {
+        unsigned long long x, y, u;
+        memcpy(&x, a + i, 8);
+        memcpy(&y, b + i, 8);
+        if ((x | y) & 0x8080808080808080)
+            break;
+        u = ((x + 0x3f3f3f3f3f3f3f3f) & ~(x + 0x2525252525252525)) & 0x8080808080808080;
+        x |= u >> 2;
+        u = ((y + 0x3f3f3f3f3f3f3f3f) & ~(y + 0x2525252525252525)) & 0x8080808080808080;
+        y |= u >> 2;
+        if (x != y)
+            break;
+    }
+    for (; i < n; ++i) {
+        if ((a[i] | b[i]) & 0200)
+            break;
+        if (FoldCase(a[i]) != FoldCase(b[i]))
+            break;
+    }
+    return i;
+}
+
+/**
+ * Compares 𝑎 and 𝑏 ignoring case, returning <0, 0, or >0.
+ *
+ * Long ASCII runs are compared many bytes at a time. Anything else is
+ * decoded and compared by codepoint under simple case folding.
+ */
+static int CompareFolded(const char *a, size_t n, const char *b, size_t m) {
+    unsigned x, y;
+    size_t i, j, k;
+    struct rune r, s;
+    for (i = j = 0;;) {
+        k = MatchAsciiFolded(a + i, b + j, Min(n - i, m - j));
+        i += k;
+        j += k;
+        if (i == n || j == m)
+            return (j < m) - (i < n);
+        r = GetUtf8(a + i, n - i);
+        s = GetUtf8(b + j, m - j);
+        if ((x = FoldCase(r.c)) != (y = FoldCase(s.c)))
+            return x < y ? -1 : 1;
+        i += r.n;
+        j += s.n;
+    }
+}
+
+/**
+ * Returns bytes of 𝑝 consumed if it starts with 𝑞 ignoring case, or -1.
+ */
+static long StartsWithFolded(const char *p, size_t n, const char *q, size_t m) {
+    size_t i, j, k;
+    struct rune r, s;
+    for (i = j = 0;;) {
+        k = MatchAsciiFolded(p + i, q + j, Min(n - i, m - j));
+        i += k;
+        j += k;
+        if (j == m)
+            return i;
+        if (i == n)
+            return -1;
+        r = GetUtf8(p + i, n - i);
+        s = GetUtf8(q + j, m - j);
+        if (FoldCase(r.c) != FoldCase(s.c))
+            return -1;
+        i += r.n;
+        j += s.n;
+    }
+}
+
+static int CompareStrings(const char *a, const char *b) {
+    return CompareFolded(a, strlen(a), b, strlen(b));
 }
 
-static const char *FindSubstringReverse(const char *p, size_t n, const char *q, size_t m) {
+/**
+ * Returns last occurrence of 𝑞 that ends within the first 𝑛 bytes of 𝑝.
+ *
+ * @param fold enables case insensitive matching
+ */
+static const char *FindSubstringReverse(const char *p, size_t n, const char *q, size_t m,
+                                        char fold) {
     size_t i;
+    if (fold) {
+        i = n;
+        do {
+            if ((i == n || (p[i] & 0300) != 0200) && StartsWithFolded(p + i, n - i, q, m) != -1) {
+                return p + i;
+            }
+        } while (i--);
+        return 0;
+    }
     if (m <= n) {
         n -= m;
         do {
@@ -1963,6 +3240,47 @@ static int ParseUnsigned(const char *s, void *e) {
     return x;
 }
 
+/**
+ * Returns length of prefix that's seven bit ASCII without ESC.
+ *
+ * This lets us count the most common kind of text without running the
+ * state machine for each byte. We classify 32 bytes at a time on AVX2,
+ * 16 bytes at a time on SSE2, and eight bytes at a time elsewhere.
+ */
+static size_t CountAscii(const char *p, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    unsigned m;
+    __m256i v, esc = _mm256_set1_epi8(033);
+    for (; i + 32 <= n; i += 32) {
+        v = _mm256_loadu_si256((const __m256i *)(p + i));
+        if ((m = _mm256_movemask_epi8(_mm256_or_si256(v, _mm256_cmpeq_epi8(v, esc)))))
+            return i + Bsf(m);
+    }
+#endif
+#if defined(__SSE2__)
+    {
+        unsigned m;
+        __m128i v, esc = _mm_set1_epi8(033);
+        for (; i + 16 <= n; i += 16) {
+            v = _mm_loadu_si128((const __m128i *)(p + i));
+            if ((m = _mm_movemask_epi8(_mm_or_si128(v, _mm_cmpeq_epi8(v, esc)))))
+                return i + Bsf(m);
+        }
+    }
+#endif
+    for (; i + 8 <= n; i += 8) {
+        unsigned long long x, y;
+        memcpy(&x, p + i, 8);
+        y = x ^ 0x1b1b1b1b1b1b1b1b;
+        if ((x | ((y - 0x0101010101010101) & ~y)) & 0x8080808080808080)
+            break;
+    }
+    while (i < n && !(p[i] & 0200) && p[i] != 033)
+        ++i;
+    return i;
+}
+
 /**
  * Returns UNICODE CJK Monospace Width of string.
  *
@@ -1972,11 +3290,17 @@ static int ParseUnsigned(const char *s, void *e) {
  */
 static size_t GetMonospaceWidth(const char *p, size_t n, char *out_haswides) {
     int c, d;
-    size_t i, w;
+    size_t i, k, w;
     struct rune r;
     char haswides;
     enum { kAscii, kUtf8, kEsc, kCsi1, kCsi2 } t;
     for (haswides = r.c = r.n = w = i = 0, t = kAscii; i < n; ++i) {
+        if (t == kAscii) {
+            k = CountAscii(p + i, n - i);
+            w += k;
+            if ((i += k) == n)
+                break;
+        }
         c = p[i] & 255;
         switch (t) {
         Whoopsie:
@@ -2043,6 +3367,22 @@ static size_t GetMonospaceWidth(const char *p, size_t n, char *out_haswides) {
     return w;
 }
 
+/**
+ * Returns monospace display width of UTF-8 string.
+ *
+ * This is the same function bestline uses to measure prompts and hints
+ * so it's useful for aligning columns of text. ANSI CSI sequences such
+ * as color codes have a width of zero. Other characters are measured
+ * using bestlineCharacterWidth() except for C0 control codes, which we
+ * count as one, and malformed UTF-8 sequences, which are skipped.
+ *
+ * @param p is a UTF-8 string that doesn't need to be NUL-terminated
+ * @param n is the number of bytes in p
+ */
+unsigned long bestlineStringWidth(const char *p, unsigned long n) {
+    return GetMonospaceWidth(p, n, 0);
+}
+
 static int bestlineIsUnsupportedTerm(void) {
     size_t i;
     char *term;
@@ -2065,6 +3405,7 @@ static int enableRawMode(int fd) {
     struct termios raw;
     struct sigaction sa;
     if (tcgetattr(fd, &orig_termios) != -1) {
+        slowlink = cfgetospeed(&orig_termios) != B0 && cfgetospeed(&orig_termios) < B38400;
         raw = orig_termios;
         raw.c_iflag &= ~(BRKINT | ICRNL | INPCK | ISTRIP | IXON);
         raw.c_lflag &= ~(ECHO | ICANON | IEXTEN | ISIG);
@@ -2148,11 +3489,194 @@ static int bestlineWriteStr(int fd, const char *p) {
     return bestlineWrite(fd, p, strlen(p));
 }
 
+/**
+ * Returns minimum microseconds between frames.
+ */
+static unsigned long bestlineFrameInterval(void) {
+    return frameinterval ? frameinterval - 1 : 1000000 / 60;
+}
+
+/**
+ * Returns microseconds until the next frame may be drawn.
+ */
+static unsigned long bestlineFrameDelay(struct bestlineState *l) {
+    unsigned long long t;
+    unsigned long i;
+    if (!(i = bestlineFrameInterval()))
+        return 0;
+    t = GetMicros() - l->drawn;
+    return t < i ? i - t : 0;
+}
+
+/**
+ * Returns true if drawing a frame should be put off, because there's
+ * more input to process, or the last frame went out too recently.
+ */
+static char bestlineFrameDefer(struct bestlineState *l) {
+    return HasPendingInput(l->ifd) || bestlineFrameDelay(l);
+}
+
+/**
+ * Sends as much of the last frame as the terminal takes without making
+ * us wait. Returns true if all of it has been sent.
+ */
+static char bestlineFlush(struct bestlineState *l) {
+    int rc;
+    while (l->sent < l->out.len) {
+        if (ispaused || _MyPoll(l->ofd, POLLOUT, 0) != 1)
+            return 0;
+        rc = _MyWrite(l->ofd, l->out.b + l->sent, Min(l->out.len - l->sent, 512));
+        if (rc > 0) {
+            l->sent += rc;
+        } else if (rc == -1 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return 0;
+        } else {
+            l->sent = l->out.len;
+            l->shown.valid = 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Sends the rest of the last frame, waiting for the terminal if needed.
+ */
+static void bestlineFlushAll(struct bestlineState *l) {
+    if (l->sent < l->out.len &&
+        bestlineWrite(l->ofd, l->out.b + l->sent, l->out.len - l->sent) == -1)
+        l->shown.valid = 0;
+    l->sent = l->out.len;
+}
+
+/**
+ * Waits for the last frame to be sent, unless there's input first.
+ *
+ * Since frames are never queued behind one another, the terminal gets
+ * the latest state of the line as soon as it catches up.
+ *
+ * @return true if all of it has been sent
+ */
+static char bestlineDrain(struct bestlineState *l) {
+    while (!bestlineFlush(l)) {
+        if (ispaused || gotint || HasPendingInput(l->ifd))
+            return 0;
+        _MyPoll(l->ofd, POLLOUT, 10);
+    }
+    return 1;
+}
+
+/**
+ * Starts sending the frame that's been generated in l->out.
+ *
+ * The final frame of a line is sent in full, since other writes come
+ * after it. The rest are sent as the terminal accepts them.
+ */
+static void bestlineFrameSend(struct bestlineState *l) {
+    l->dirty = 0;
+    if (bestlineFrameInterval())
+        l->drawn = GetMicros();
+    l->sent = 0;
+    l->shown.valid = 1;
+    if (l->final) {
+        bestlineFlushAll(l);
+    } else {
+        bestlineFlush(l);
+    }
+}
+
+/**
+ * Waits for input until it's time to draw a squashed frame.
+ *
+ * @return true if input arrived first, in which case it should be
+ *     handled before drawing, so a burst of keystrokes is coalesced
+ */
+static char bestlineFrameWait(struct bestlineState *l) {
+    unsigned long us;
+    if (!(us = bestlineFrameDelay(l)))
+        return 0;
+    return HasPendingInput(l->ifd) || _MyPoll(l->ifd, POLLIN, (us + 999) / 1000) == 1;
+}
+
+/**
+ * Returns true if 𝑝 is the terminal's answer to "\033[?2026$p", in
+ * which case we remember if it supports synchronized output.
+ */
+static char bestlineIsSyncReply(const char *p, size_t size, ssize_t n) {
+    if (n < 11 || (size_t)n >= size || memcmp(p, "\033[?2026;", 8) || p[n - 2] != '$' ||
+        p[n - 1] != 'y')
+        return 0;
+    syncmode = p[8] == '1' || p[8] == '2'; /* set or reset */
+    return 1;
+}
+
+/**
+ * Takes in async hints that have arrived, dropping stale ones.
+ *
+ * @return true if a hint for the current line came in
+ */
+static char bestlineHintsReceive(struct bestlineState *l) {
+    char got;
+    unsigned n;
+    char msg[PIPE_BUF];
+    struct bestlineHintHeader h;
+    got = 0;
+    while (read(hintsfd[0], &h, sizeof(h)) == sizeof(h)) {
+        n = h.n[0] + h.n[1] + h.n[2];
+        if (n > sizeof(msg) || read(hintsfd[0], msg, n) != n)
+            break; /* can't happen, since writes are atomic */
+        if (h.gen != l->hintgen)
+            continue;
+        got = 1;
+        abClear(&l->hint);
+        if (!h.n[0])
+            continue;
+        abAppend(&l->hint, msg, h.n[0]);
+        abAppend(&l->hint, "", 1);
+        abAppend(&l->hint, msg + h.n[0], h.n[1]);
+        abAppend(&l->hint, "", 1);
+        abAppend(&l->hint, msg + h.n[0] + h.n[1], h.n[2]);
+    }
+    return got;
+}
+
+/**
+ * Waits for input, taking in async hints while we're at it.
+ *
+ * @return true if a hint came in or a signal arrived, in which case
+ *     the caller should go around its loop again
+ */
+static char bestlineHintsWait(struct bestlineState *l) {
+    int rc;
+    struct pollfd p[2];
+    if (!asyncHintsCallback || !hintsopen)
+        return 0;
+    for (;;) {
+        if (bestlineHintsReceive(l)) {
+            l->dirty = 1;
+            return 1;
+        }
+        if (HasPendingInput(l->ifd))
+            return 0;
+        if (_MyPoll != MyPoll) {
+            /* custom i/o can't be polled alongside our pipe */
+            rc = _MyPoll(l->ifd, POLLIN, 10);
+        } else {
+            p[0].fd = l->ifd;
+            p[0].events = POLLIN;
+            p[1].fd = hintsfd[0];
+            p[1].events = POLLIN;
+            rc = poll(p, 2, -1);
+        }
+        if (rc == -1)
+            return errno == EINTR;
+    }
+}
+
 static ssize_t bestlineRead(int fd, char *buf, size_t size, struct bestlineState *l) {
-    size_t got;
     ssize_t rc;
     int refreshme;
-    do {
+    struct bestlineKey key;
+    for (;;) {
         refreshme = 0;
         if (gotint) {
             errno = EINTR;
@@ -2160,23 +3684,23 @@ static ssize_t bestlineRead(int fd, char *buf, size_t size, struct bestlineState
         }
         if (gotcont && rawmode != -1) {
             enableRawMode(rawmode);
-            if (l)
+            if (l) {
+                l->shown.valid = 0; /* screen may have been scribbled on */
                 refreshme = 1;
+            }
         }
         if (gotwinch && l) {
             refreshme = 1;
         }
         if (refreshme)
             bestlineRefreshLine(l);
-        rc = bestlineReadCharacter(fd, buf, size);
-    } while (rc == -1 && errno == EINTR);
-    if (rc != -1) {
-        got = rc;
-        if (got > 0 && l) {
-            memcpy(l->seq[1], l->seq[0], sizeof(l->seq[0]));
-            memset(l->seq[0], 0, sizeof(l->seq[0]));
-            memcpy(l->seq[0], buf, Min(Min(size, got), sizeof(l->seq[0]) - 1));
-        }
+        if (l && bestlineDrain(l) && l->dirty && !bestlineFrameWait(l))
+            bestlineRefreshLineForce(l);
+        if (l && bestlineHintsWait(l))
+            continue;
+        rc = bestlineDecode(fd, buf, size, l ? &l->key : &key);
+        if ((rc != -1 || errno != EINTR) && !bestlineIsSyncReply(buf, size, rc))
+            break;
     }
     return rc;
 }
@@ -2251,6 +3775,245 @@ static char bestlineGrow(struct bestlineState *ls, size_t n) {
     return 1;
 }
 
+static char bestlineLayoutReserve(unsigned **p, unsigned *cap, size_t n) {
+    size_t m;
+    unsigned *q;
+    m = *cap;
+    if (m >= n)
+        return 1;
+    do
+        m += (m >> 1) + 16;
+    while (m < n);
+    if (!(q = (unsigned *)realloc(*p, m * sizeof(**p))))
+        return 0;
+    *p = q;
+    *cap = m;
+    return 1;
+}
+
+static void bestlineLayoutFree(struct bestlineState *l) {
+    free(l->lay.col);
+    free(l->lay.row);
+    free(l->lay.brk);
+    free(l->lay.run);
+    l->lay.col = 0;
+    l->lay.row = 0;
+    l->lay.brk = 0;
+    l->lay.run = 0;
+}
+
+static void bestlineSetPrompt(struct bestlineState *l, const char *prompt) {
+    l->prompt = prompt;
+    l->lay.plen = strlen(prompt);
+    l->lay.pwidth = GetMonospaceWidth(prompt, l->lay.plen, 0);
+}
+
+/**
+ * Forgets cached layout for buf[pos] onwards.
+ *
+ * This must be called by anything that changes the line buffer, where
+ * pos is the first byte that was changed.
+ */
+static void bestlineLayoutInvalidate(struct bestlineState *l, unsigned pos) {
+    l->lay.valid = Min(l->lay.valid, pos);
+    l->hl.valid = Min(l->hl.valid, pos);
+    l->hl.done = 0;
+    l->hintgen = 0;
+    l->hint.len = 0;
+}
+
+/* classes of grapheme clusters for word and expression motion */
+enum { kRunWord, kRunSpace, kRunOpen, kRunClose };
+#define kRunSeparator (1 << kRunSpace | 1 << kRunOpen | 1 << kRunClose)
+#define kRunAll       (1 << kRunWord | kRunSeparator)
+
+static char IsGraphemeStart(struct bestlineLayout *y, unsigned i) {
+    return y->brk[i >> 5] >> (i & 31) & 1;
+}
+
+/**
+ * Returns class of cluster starting with 𝑐, where space means any
+ * separator that isn't a bracket.
+ */
+static int GetRunClass(unsigned c) {
+    if (!bestlineIsSeparator(c))
+        return kRunWord;
+    if (bestlineMirrorRight(c))
+        return kRunOpen;
+    if (bestlineMirrorLeft(c))
+        return kRunClose;
+    return kRunSpace;
+}
+
+/**
+ * Returns bits of cluster starts in buf[k*32,k*32+32) whose class is in
+ * the 𝑚𝑎𝑠𝑘, plus the bit for the end of the line if it's in that word.
+ */
+static unsigned GetRuns(struct bestlineLayout *y, unsigned k, unsigned mask) {
+    unsigned b, c, e;
+    const unsigned *r = y->run + k * 4;
+    e = y->brk[k] & ~(r[0] | r[1] | r[2] | r[3]);
+    for (b = c = 0; c < 4; ++c)
+        if (mask >> c & 1)
+            b |= r[c];
+    return b | e;
+}
+
+/**
+ * Returns first cluster start at or after 𝑝𝑜𝑠 whose class is in 𝑚𝑎𝑠𝑘,
+ * otherwise the length of the line.
+ */
+static unsigned NextRun(struct bestlineLayout *y, unsigned pos, unsigned mask) {
+    unsigned k, b;
+    k = pos >> 5;
+    b = GetRuns(y, k, mask) & -1u << (pos & 31);
+    while (!b)
+        b = GetRuns(y, ++k, mask);
+    return k << 5 | Bsf(b);
+}
+
+/**
+ * Returns last cluster start before 𝑝𝑜𝑠 whose class is in 𝑚𝑎𝑠𝑘, or -1.
+ */
+static long PrevRun(struct bestlineLayout *y, unsigned pos, unsigned mask) {
+    unsigned k, b;
+    if (!pos)
+        return -1;
+    k = --pos >> 5;
+    b = GetRuns(y, k, mask) & ((2u << (pos & 31)) - 1);
+    while (!b && k)
+        b = GetRuns(y, --k, mask);
+    return b ? (long)(k << 5 | Bsr(b)) : -1;
+}
+
+/**
+ * Brings the cached column widths up to date with the line buffer.
+ *
+ * The work done here is proportional to the number of bytes that were
+ * invalidated since the last call. Row breaks starting at or after the
+ * first rune we recompute are discarded too. Grapheme boundaries are
+ * recomputed from the start of the cluster that contains that rune,
+ * since the break state machine is known to be zero there.
+ */
+static char bestlineLayoutUpdate(struct bestlineState *l) {
+    struct rune r;
+    unsigned i, j, k, w, x, s, state;
+    struct bestlineLayout *y = &l->lay;
+    if (y->col && y->valid >= l->len && y->end == l->len)
+        return 1;
+    if (!bestlineLayoutReserve(&y->col, &y->colcap, l->len + 1) ||
+        !bestlineLayoutReserve(&y->brk, &y->brkcap, (l->len >> 5) + 1) ||
+        !bestlineLayoutReserve(&y->run, &y->runcap, ((l->len >> 5) + 1) * 4))
+        return 0;
+    /* restart at the rune containing the last byte we still trust */
+    if ((i = Min(y->valid, Min(y->end, l->len)))) {
+        do
+            --i;
+        while (i && (l->buf[i] & 0300) == 0200);
+    }
+    /* forget wide runes we're about to recompute */
+    if (y->end) {
+        for (k = i; k < y->end; k = j) {
+            for (j = k + 1; y->col[j] == -1u; ++j) {
+            }
+            y->wides -= y->col[j] - y->col[k] > 1;
+        }
+    }
+    if (y->rend > i) {
+        y->rend = i;
+        while (y->nrows > 1 && y->row[y->nrows - 1] >= i)
+            --y->nrows;
+    }
+    for (s = i, x = i ? y->col[i] : 0; i < l->len; i += r.n) {
+        r = GetUtf8(l->buf + i, l->len - i);
+        w = bestlineCharacterWidth(r.c);
+        y->col[i] = x;
+        for (k = 1; k < r.n; ++k)
+            y->col[i + k] = -1u;
+        y->wides += w > 1;
+        x += w;
+    }
+    y->col[l->len] = x;
+    while (s && !IsGraphemeStart(y, --s)) {
+    }
+    y->brk[s >> 5] &= (1u << (s & 31)) - 1;
+    for (k = 0; k < 4; ++k)
+        y->run[(s >> 5) * 4 + k] &= (1u << (s & 31)) - 1;
+    for (k = (s >> 5) + 1; k <= l->len >> 5; ++k) {
+        y->brk[k] = 0;
+        memset(y->run + k * 4, 0, 4 * sizeof(*y->run));
+    }
+    for (state = 0; s < l->len; s += r.n) {
+        r = GetUtf8(l->buf + s, l->len - s);
+        if (bestlineGraphemeBreak(&state, r.c)) {
+            y->brk[s >> 5] |= 1u << (s & 31);
+            y->run[(s >> 5) * 4 + GetRunClass(r.c)] |= 1u << (s & 31);
+        }
+    }
+    y->brk[l->len >> 5] |= 1u << (l->len & 31);
+    y->valid = y->end = l->len;
+    return 1;
+}
+
+/**
+ * Computes where rows break when buf[start,end) is displayed on a
+ * terminal that's xn columns wide, with the first row starting at
+ * column x0. This must be called after bestlineLayoutUpdate().
+ *
+ * The wrapping rule must be kept in sync with the rendering loop in
+ * bestlineRefreshLineImpl(), which breaks before any rune that would
+ * fail to fit, after using its byte length as a conservative estimate
+ * of how many cells the terminal is going to consume.
+ */
+static char bestlineLayoutRows(struct bestlineState *l, unsigned start, unsigned end, unsigned xn,
+                               unsigned x0) {
+    unsigned i, j, k, x;
+    struct bestlineLayout *y = &l->lay;
+    if (!y->nrows || y->row[0] != start || y->rend < start || y->xn != xn || y->x0 != x0) {
+        if (!bestlineLayoutReserve(&y->row, &y->rowcap, 1))
+            return 0;
+        y->row[0] = start;
+        y->rend = start;
+        y->nrows = 1;
+        y->xn = xn;
+        y->x0 = x0;
+    }
+    k = y->nrows - 1;
+    x = (k ? 0 : x0) + y->col[y->rend] - y->col[y->row[k]];
+    for (i = y->rend; i < end; i = j) {
+        for (j = i + 1; y->col[j] == -1u; ++j) {
+        }
+        if (x && x + (j - i) > xn) {
+            if (!bestlineLayoutReserve(&y->row, &y->rowcap, y->nrows + 1))
+                return 0;
+            y->row[y->nrows++] = i;
+            x = 0;
+        }
+        x += y->col[j] - y->col[i];
+        y->rend = j;
+    }
+    return 1;
+}
+
+/* Returns index of the row that contains buf[i]. */
+static unsigned bestlineLayoutRow(struct bestlineLayout *y, unsigned i) {
+    unsigned m, lo, hi;
+    for (lo = 0, hi = y->nrows; hi - lo > 1;) {
+        m = (lo + hi) >> 1;
+        if (y->row[m] <= i) {
+            lo = m;
+        } else {
+            hi = m;
+        }
+    }
+    return lo;
+}
+
+/* Returns column at which buf[i] is displayed, if it's on row k. */
+static unsigned bestlineLayoutColumn(struct bestlineLayout *y, unsigned k, unsigned i) {
+    return (k ? 0 : y->x0) + y->col[i] - y->col[y->row[k]];
+}
+
 /* This is an helper function for bestlineEdit() and is called when the
  * user types the <tab> key in order to complete the string currently in the
  * input.
@@ -2278,10 +4041,12 @@ static ssize_t bestlineCompleteLine(struct bestlineState *ls, char *seq, int siz
                 ls->len = strlen(lc.cvec[i]);
                 ls->pos = original.pos + ls->len - original.len;
                 ls->buf = lc.cvec[i];
+                bestlineLayoutInvalidate(ls, 0);
                 bestlineRefreshLine(ls);
                 ls->len = saved.len;
                 ls->pos = saved.pos;
                 ls->buf = saved.buf;
+                bestlineLayoutInvalidate(ls, 0);
                 if (lc.len == 1) {
                     nread = 0;
                     goto FinishQuickly;
@@ -2307,6 +4072,7 @@ static ssize_t bestlineCompleteLine(struct bestlineState *ls, char *seq, int siz
                     if (bestlineGrow(ls, n + 1)) {
                         memcpy(ls->buf, lc.cvec[i], n + 1);
                         ls->len = n;
+                        bestlineLayoutInvalidate(ls, 0);
                         ls->pos = original.pos + n - original.len;
                     }
                 }
@@ -2335,6 +4101,7 @@ static void bestlineEditHistoryGoto(struct bestlineState *l, unsigned i) {
     memcpy(l->buf, history[historylen - 1 - l->hindex], n);
     l->buf[n] = 0;
     l->len = l->pos = n;
+    bestlineLayoutInvalidate(l, 0);
     bestlineRefreshLine(l);
 }
 
@@ -2355,9 +4122,23 @@ static char *bestlineMakeSearchPrompt(struct abuf *ab, int fail, const char *s,
     return ab->b;
 }
 
+/**
+ * Returns true if 𝑠 has a character that lowercasing would change.
+ */
+static char HasUppercase(const char *s, size_t n) {
+    size_t i;
+    struct rune r;
+    for (i = 0; i < n; i += r.n) {
+        r = GetUtf8(s + i, n - i);
+        if (bestlineLowercase(r.c) != r.c)
+            return 1;
+    }
+    return 0;
+}
+
 static int bestlineSearch(struct bestlineState *l, char *seq, int size) {
     char *p;
-    char isstale;
+    char fold, isstale;
     struct abuf ab;
     struct abuf prompt;
     unsigned i, j, k, matlen;
@@ -2371,7 +4152,7 @@ static int bestlineSearch(struct bestlineState *l, char *seq, int size) {
     oldprompt = l->prompt;
     oldindex = l->hindex;
     for (fail = matlen = 0;;) {
-        l->prompt = bestlineMakeSearchPrompt(&prompt, fail, ab.b, matlen);
+        bestlineSetPrompt(l, bestlineMakeSearchPrompt(&prompt, fail, ab.b, matlen));
         bestlineRefreshLine(l);
         fail = 1;
         added = 0;
@@ -2406,6 +4187,7 @@ static int bestlineSearch(struct bestlineState *l, char *seq, int size) {
             break;
         }
         isstale = 0;
+        fold = smartcase && !HasUppercase(ab.b, ab.len);
         while (i < historylen) {
             p = history[historylen - 1 - i];
             k = strlen(p);
@@ -2415,7 +4197,7 @@ static int bestlineSearch(struct bestlineState *l, char *seq, int size) {
                 isstale = 0;
                 j = k;
             }
-            if ((q = FindSubstringReverse(p, j, ab.b, ab.len))) {
+            if ((q = FindSubstringReverse(p, j, ab.b, ab.len, fold))) {
                 bestlineEditHistoryGoto(l, i);
                 l->pos = q - p;
                 fail = 0;
@@ -2430,7 +4212,7 @@ static int bestlineSearch(struct bestlineState *l, char *seq, int size) {
             }
         }
     }
-    l->prompt = oldprompt;
+    bestlineSetPrompt(l, oldprompt);
     bestlineRefreshLine(l);
     abFree(&prompt);
     abFree(&ab);
@@ -2448,6 +4230,63 @@ static void bestlineRingFree(void) {
     }
 }
 
+static void bestlineHintsFree(void) {
+    size_t i;
+    for (i = 0; i < BESTLINE_MAX_HINTS; ++i) {
+        abFree(&hints[i].data);
+        memset(hints + i, 0, sizeof(hints[i]));
+    }
+}
+
+static unsigned long long HashBytes(const char *p, size_t n) {
+    unsigned long long h = 0xcbf29ce484222325;
+    while (n--)
+        h = (h ^ (*p++ & 255)) * 0x100000001b3;
+    return h;
+}
+
+/**
+ * Returns what the hints callback says for 𝑠, asking it only if 𝑠
+ * isn't among the most recently used lines.
+ */
+static struct bestlineHint *bestlineHintsLookup(const char *s, unsigned n) {
+    char *hint;
+    unsigned long long h;
+    struct bestlineHint *e, *lru;
+    const char *ansi1 = "\033[90m", *ansi2 = "\033[39m";
+    h = HashBytes(s, n);
+    for (lru = e = hints; e < hints + BESTLINE_MAX_HINTS; ++e) {
+        if (e->used && e->hash == h && e->len == n && !memcmp(e->data.b, s, n)) {
+            e->used = ++hintstick;
+            return e;
+        }
+        if (e->used < lru->used)
+            lru = e;
+    }
+    e = lru;
+    e->used = ++hintstick;
+    e->hash = h;
+    e->len = n;
+    abClear(&e->data);
+    abAppend(&e->data, s, n);
+    abAppend(&e->data, "", 1);
+    if ((hint = hintsCallback(s, &ansi1, &ansi2))) {
+        e->none = 0;
+        abAppends(&e->data, hint);
+        abAppend(&e->data, "", 1);
+        abAppends(&e->data, ansi1 ? ansi1 : "");
+        abAppend(&e->data, "", 1);
+        abAppends(&e->data, ansi2 ? ansi2 : "");
+        if (freeHintsCallback)
+            freeHintsCallback(hint);
+    } else {
+        e->none = 1;
+    }
+    if (!e->data.b) /* out of memory */
+        e->used = 0;
+    return e;
+}
+
 static void bestlineRingPush(const char *p, size_t n) {
     char *q;
     if (!n)
@@ -2469,43 +4308,65 @@ static void bestlineRingRotate(void) {
     }
 }
 
-static char *bestlineRefreshHints(struct bestlineState *l) {
-    char *hint;
-    struct abuf ab;
-    const char *ansi1 = "\033[90m", *ansi2 = "\033[39m";
-    if (!hintsCallback)
-        return 0;
-    if (!(hint = hintsCallback(l->buf, &ansi1, &ansi2)))
-        return 0;
-    abInit(&ab);
-    if (ansi1)
-        abAppends(&ab, ansi1);
-    abAppends(&ab, hint);
-    if (ansi2)
-        abAppends(&ab, ansi2);
-    if (freeHintsCallback)
-        freeHintsCallback(hint);
-    return ab.b;
+/**
+ * Returns end of grapheme cluster at 𝑝𝑜𝑠.
+ */
+static size_t Forward(struct bestlineState *l, size_t pos) {
+    if (!bestlineLayoutUpdate(l))
+        return pos + GetUtf8(l->buf + pos, l->len - pos).n;
+    while (pos < l->len && !IsGraphemeStart(&l->lay, ++pos)) {
+    }
+    return pos;
 }
 
+/**
+ * Returns start of grapheme cluster before 𝑝𝑜𝑠.
+ */
 static size_t Backward(struct bestlineState *l, size_t pos) {
-    if (pos) {
-        do
-            --pos;
-        while (pos && (l->buf[pos] & 0300) == 0200);
+    if (!bestlineLayoutUpdate(l)) {
+        if (pos) {
+            do
+                --pos;
+            while (pos && (l->buf[pos] & 0300) == 0200);
+        }
+        return pos;
+    }
+    while (pos && !IsGraphemeStart(&l->lay, --pos)) {
     }
     return pos;
 }
 
+/**
+ * Returns last bracket cluster before 𝑝𝑜𝑠, or -1 if there's none.
+ *
+ * If the layout index can't be allocated then this returns the start
+ * of the previous cluster, and the caller has to check what it is.
+ */
+static long PrevBracket(struct bestlineState *l, unsigned pos) {
+    if (bestlineLayoutUpdate(l))
+        return PrevRun(&l->lay, pos, 1 << kRunOpen | 1 << kRunClose);
+    return pos ? (long)Backward(l, pos) : -1;
+}
+
+/**
+ * Returns first bracket cluster after 𝑝𝑜𝑠, or the length of the line.
+ */
+static unsigned NextBracket(struct bestlineState *l, unsigned pos) {
+    if (bestlineLayoutUpdate(l))
+        return NextRun(&l->lay, pos + 1, 1 << kRunOpen | 1 << kRunClose);
+    return pos + GetUtf8(l->buf + pos, l->len - pos).n;
+}
+
 static int bestlineEditMirrorLeft(struct bestlineState *l, int res[2]) {
+    long j;
     unsigned c, pos, left, right, depth, index;
     if ((pos = Backward(l, l->pos))) {
         right = GetUtf8(l->buf + pos, l->len - pos).c;
         if ((left = bestlineMirrorLeft(right))) {
             depth = 0;
             index = pos;
-            do {
-                pos = Backward(l, pos);
+            while ((j = PrevBracket(l, pos)) != -1) {
+                pos = j;
                 c = GetUtf8(l->buf + pos, l->len - pos).c;
                 if (c == right) {
                     ++depth;
@@ -2518,7 +4379,7 @@ static int bestlineEditMirrorLeft(struct bestlineState *l, int res[2]) {
                         return 0;
                     }
                 }
-            } while (pos);
+            }
         }
     }
     return -1;
@@ -2533,8 +4394,7 @@ static int bestlineEditMirrorRight(struct bestlineState *l, int res[2]) {
     if ((right = bestlineMirrorRight(left))) {
         depth = 0;
         index = pos;
-        do {
-            pos += rune.n;
+        while ((pos = NextBracket(l, pos)) < l->len) {
             rune = GetUtf8(l->buf + pos, l->len - pos);
             if (rune.c == left) {
                 ++depth;
@@ -2547,7 +4407,7 @@ static int bestlineEditMirrorRight(struct bestlineState *l, int res[2]) {
                     return 0;
                 }
             }
-        } while (pos + rune.n < l->len);
+        }
     }
     return -1;
 }
@@ -2560,18 +4420,534 @@ static int bestlineEditMirror(struct bestlineState *l, int res[2]) {
     return rc;
 }
 
-static void bestlineRefreshLineImpl(struct bestlineState *l, int force) {
+/**
+ * Chooses the part of the line to show when it's too wide for the
+ * display, i.e. the first 𝑐𝑎𝑝 columns starting at l->vstart.
+ *
+ * The window is only moved once the cursor leaves it, which centers
+ * the cursor again. It's also pulled back if there'd be unused space
+ * at the end. Only clusters within the window get visited.
+ *
+ * @return end of window, which is never before the cursor
+ */
+static unsigned bestlineViewport(struct bestlineState *l, unsigned cap) {
+    size_t i, j;
+    unsigned *col = l->lay.col;
+    for (i = Min(l->vstart, l->len); i && !IsGraphemeStart(&l->lay, i); --i) {
+    }
+    if (l->pos < i || col[l->pos] - col[i] > cap) {
+        for (i = l->pos; i && col[l->pos] - col[j = Backward(l, i)] <= cap / 2; i = j) {
+        }
+    }
+    while (i && col[l->len] - col[j = Backward(l, i)] <= cap)
+        i = j;
+    l->vstart = i;
+    for (j = i; j < l->len && col[Forward(l, j)] - col[i] <= cap;)
+        j = Forward(l, j);
+    return Max(j, l->pos);
+}
+
+enum { kCellBold = 1, kCellHead = 2, kCellHint = 4, kCellStyle = 8 };
+
+static void bestlineFrameFree(struct bestlineFrame *f) {
+    free(f->cell);
+    free(f->row);
+    free(f->text.b);
+    memset(f, 0, sizeof(*f));
+}
+
+static void bestlineRenderFree(struct bestlineState *l) {
+    bestlineFlushAll(l);
+    bestlineFrameFree(&l->shown);
+    bestlineFrameFree(&l->next);
+    abFree(&l->out);
+    abFree(&l->hint);
+    free(l->hl.span);
+    free(l->hl.ck);
+    memset(&l->hl, 0, sizeof(l->hl));
+}
+
+/**
+ * Forgets what's on the screen, so the next refresh redraws everything
+ * starting at the row the cursor is on.
+ *
+ * This must be called by anything that writes to the terminal, other
+ * than bestlineRefreshLineImpl().
+ */
+static void bestlineFrameReset(struct bestlineState *l) {
+    l->shown.valid = 0;
+    l->shown.rows = 0;
+    l->shown.cy = 0;
+}
+
+static char bestlineFrameRow(struct bestlineFrame *f) {
+    if (!bestlineLayoutReserve(&f->row, &f->rowcap, f->rows + 2))
+        return 0;
+    f->row[f->rows++] = f->ncells;
+    return 1;
+}
+
+static char bestlineFrameCell(struct bestlineFrame *f, const char *p, unsigned n, unsigned w,
+                              unsigned a) {
+    unsigned m;
+    struct bestlineCell *c;
+    if (f->ncells == f->cellcap) {
+        m = f->cellcap + (f->cellcap >> 1) + 16;
+        if (!(c = (struct bestlineCell *)realloc(f->cell, m * sizeof(*c))))
+            return 0;
+        f->cell = c;
+        f->cellcap = m;
+    }
+    if (!f->text.b)
+        abInit(&f->text);
+    m = f->text.len;
+    abAppend(&f->text, p, n);
+    if (f->text.len != m + n)
+        return 0;
+    c = f->cell + f->ncells++;
+    c->i = m;
+    c->n = n;
+    c->w = w;
+    c->a = a;
+    f->attrs |= a;
+    return 1;
+}
+
+/**
+ * Adds hint cell to end of frame, if it fits in 𝑟𝑜𝑜𝑚.
+ */
+static void bestlineFrameHint(struct bestlineFrame *f, const char *hint, const char *ansi1,
+                              const char *ansi2, unsigned room) {
+    unsigned i, w, attrs;
+    attrs = f->attrs;
+    if (bestlineFrameCell(f, "", 0, 0, kCellHead | kCellHint)) {
+        i = f->text.len;
+        if (ansi1)
+            abAppends(&f->text, ansi1);
+        abAppends(&f->text, hint);
+        if (ansi2)
+            abAppends(&f->text, ansi2);
+        w = GetMonospaceWidth(f->text.b + i, f->text.len - i, 0);
+        if (w < room) {
+            f->cell[f->ncells - 1].n = f->text.len - i;
+            f->cell[f->ncells - 1].w = w;
+        } else {
+            f->text.len = i;
+            f->attrs = attrs;
+            --f->ncells;
+        }
+    }
+}
+
+/**
+ * Adds hint to end of frame, if there is one, and it fits in 𝑟𝑜𝑜𝑚.
+ *
+ * The hint and its colors are appended straight to the frame's text,
+ * which keeps its memory between refreshes. Async hints are requested
+ * the first time a line is drawn after it changes, and drawn once the
+ * answer for that generation has come in.
+ */
+static void bestlineRefreshHints(struct bestlineState *l, struct bestlineFrame *f,
+                                 unsigned room) {
     char *hint;
-    char flipit;
+    struct bestlineHint *e;
+    const char *ansi1 = "\033[90m", *ansi2 = "\033[39m";
+    if (asyncHintsCallback && hintsopen) {
+        if (!l->hintgen) {
+            l->hintgen = ++hintsgen;
+            asyncHintsCallback(l->buf, l->hintgen);
+        }
+        if (l->hint.len) {
+            ansi1 = l->hint.b + strlen(l->hint.b) + 1;
+            ansi2 = ansi1 + strlen(ansi1) + 1;
+            bestlineFrameHint(f, l->hint.b, ansi1, ansi2, room);
+        }
+        return;
+    }
+    if (!hintsCallback)
+        return;
+    if (!hintsnocache) {
+        e = bestlineHintsLookup(l->buf, l->len);
+        if (!e->none && e->used) {
+            hint = e->data.b + e->len + 1;
+            ansi1 = hint + strlen(hint) + 1;
+            ansi2 = ansi1 + strlen(ansi1) + 1;
+            bestlineFrameHint(f, hint, ansi1, ansi2, room);
+        }
+        return;
+    }
+    if (!(hint = hintsCallback(l->buf, &ansi1, &ansi2)))
+        return;
+    bestlineFrameHint(f, hint, ansi1, ansi2, room);
+    if (freeHintsCallback)
+        freeHintsCallback(hint);
+}
+
+/**
+ * Returns index of first span that ends after 𝑖.
+ */
+static unsigned bestlineSpanFind(struct bestlineHighlights *h, unsigned i) {
+    unsigned lo, hi, mid;
+    for (lo = 0, hi = h->n; lo < hi;) {
+        mid = lo + (hi - lo) / 2;
+        if (h->span[mid].end <= i) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Asks highlight callback about whatever changed since it last did.
+ *
+ * The callback resumes at the last checkpoint before the first byte
+ * that was edited. Spans after that point are thrown away.
+ */
+static void bestlineHighlightUpdate(struct bestlineState *l) {
+    unsigned i, c;
+    unsigned long state;
+    struct bestlineHighlights *h = &l->hl;
+    if (h->done)
+        return;
+    for (i = h->nck; i && h->ck[i - 1].pos >= h->valid; --i) {
+    }
+    if (i) {
+        c = h->ck[i - 1].pos;
+        state = h->ck[i - 1].state;
+    } else {
+        c = 0;
+        state = 0;
+    }
+    h->nck = i;
+    i = bestlineSpanFind(h, c);
+    if (i < h->n && h->span[i].start < c)
+        h->span[i++].end = c;
+    h->n = i;
+    h->resume = c;
+    h->len = l->len;
+    highlightCallback(l->buf, l->len, c, state, h);
+    h->valid = l->len;
+    h->done = 1;
+}
+
+static char bestlineCellEqual(struct bestlineFrame *f, unsigned i, struct bestlineFrame *g,
+                              unsigned j) {
+    struct bestlineCell *a = f->cell + i, *b = g->cell + j;
+    return a->n == b->n && a->w == b->w && a->a == b->a &&
+           !memcmp(f->text.b + a->i, g->text.b + b->i, a->n);
+}
+
+static unsigned bestlineFrameWidth(struct bestlineFrame *f, unsigned i, unsigned j) {
+    unsigned w;
+    for (w = 0; i < j; ++i)
+        w += f->cell[i].w;
+    return w;
+}
+
+/**
+ * Appends cells [𝑖,𝑗) of frame, starting and ending with the default
+ * graphic rendition. Codes are only sent where the style changes.
+ */
+static void bestlineFrameEmit(struct abuf *ab, struct bestlineFrame *f, unsigned i, unsigned j) {
+    unsigned s, t;
+    for (t = 0; i < j; ++i) {
+        if ((s = f->cell[i].a / kCellStyle) != t) {
+            abAppends(ab, "\033[");
+            if (s && t)
+                abAppends(ab, "0;");
+            if (s)
+                abAppends(ab, styles[s - 1]);
+            abAppendw(ab, 'm');
+            t = s;
+        }
+        if (f->cell[i].a & kCellBold)
+            abAppends(ab, "\033[1m");
+        abAppend(ab, f->text.b + f->cell[i].i, f->cell[i].n);
+        if (f->cell[i].a & kCellBold) {
+            abAppends(ab, "\033[22m");
+            if (t)
+                t = -1u; /* style might have been bold */
+        }
+    }
+    if (t)
+        abAppends(ab, "\033[m");
+}
+
+static char bestlineIsLowBandwidth(void) {
+    return lowbandwidth ? lowbandwidth - 1 : slowlink;
+}
+
+/* Returns length of CSI sequence whose parameter is 𝑛. */
+static unsigned CsiLength(unsigned n) {
+    unsigned k = 3;
+    if (n != 1) {
+        do
+            ++k;
+        while ((n /= 10));
+    }
+    return k;
+}
+
+/* Appends CSI sequence, leaving out the parameter if it's 1. */
+static void abAppendCsi(struct abuf *ab, unsigned n, int c) {
+    abAppends(ab, "\033[");
+    if (n != 1)
+        abAppendu(ab, n);
+    abAppendw(ab, c);
+}
+
+/**
+ * Returns index of cluster that starts at column 𝑥 on row 𝑦 of frame,
+ * or end of row if that's where 𝑥 is, otherwise -1.
+ */
+static long bestlineFrameFind(struct bestlineFrame *f, unsigned y, unsigned x) {
+    unsigned i, c, e = f->row[y + 1];
+    for (c = 0, i = f->row[y]; i < e && c < x; ++i)
+        c += f->cell[i].w;
+    while (i < e && !f->cell[i].w && !(f->cell[i].a & kCellHead))
+        ++i;
+    if (c != x || (i < e && !(f->cell[i].a & kCellHead)))
+        return -1;
+    return i;
+}
+
+/**
+ * Moves cursor horizontally using as few bytes as possible.
+ *
+ * Besides relative motion and carriage return, we consider backspace,
+ * absolute column, and drawing the cells we'd otherwise move across.
+ * Absolute rows aren't known, since we don't ask where the line is.
+ */
+static void bestlineMoveColumn(struct abuf *ab, struct bestlineFrame *f, unsigned y,
+                               unsigned cx, unsigned x) {
+    long i, j, k;
+    unsigned n, best;
+    int how;
+    best = CsiLength(x + 1);
+    how = 'G'; /* cursor horizontal absolute */
+    if ((n = 1 + (x ? CsiLength(x) : 0)) < best) {
+        best = n;
+        how = '\r';
+    }
+    if ((n = CsiLength(x < cx ? cx - x : x - cx)) < best) {
+        best = n;
+        how = x < cx ? 'D' : 'C';
+    }
+    if (x < cx && cx - x < best) {
+        best = cx - x;
+        how = '\b';
+    }
+    if (x > cx && y < f->rows && (i = bestlineFrameFind(f, y, cx)) != -1 &&
+        (j = bestlineFrameFind(f, y, x)) != -1) {
+        for (n = 0, k = i; k < j && n < best; ++k)
+            n += f->cell[k].n + (f->cell[k].a & kCellBold ? 9 : 0) +
+                 (f->cell[k].a / kCellStyle ? 8 : 0);
+        if (n < best) {
+            bestlineFrameEmit(ab, f, i, j);
+            return;
+        }
+    }
+    switch (how) {
+    case 'G':
+        abAppendCsi(ab, x + 1, 'G');
+        break;
+    case '\r':
+        abAppendw(ab, '\r');
+        if (x)
+            abAppendCsi(ab, x, 'C');
+        break;
+    case '\b':
+        for (n = cx - x; n--;)
+            abAppendw(ab, '\b');
+        break;
+    default:
+        abAppendCsi(ab, x < cx ? cx - x : x - cx, how);
+        break;
+    }
+}
+
+/**
+ * Moves terminal cursor from (𝑐𝑦,𝑐𝑥) to (𝑦,𝑥) relative to the frame.
+ *
+ * Row 𝑦 needs to already be on the screen, where frame 𝑓 says what's
+ * on it. A column of 𝑥𝑛 or more means the terminal might be holding a
+ * pending wrap, in which case we can't trust it and use carriage return
+ * to get our bearings.
+ */
+static void bestlineMoveCursor(struct abuf *ab, struct bestlineFrame *f, unsigned *cy,
+                               unsigned *cx, unsigned y, unsigned x) {
+    char lowbw = bestlineIsLowBandwidth();
+    if (y != *cy) {
+        if (lowbw) {
+            abAppendCsi(ab, y < *cy ? *cy - y : y - *cy, y < *cy ? 'A' : 'B');
+        } else {
+            abAppends(ab, "\033[");
+            abAppendu(ab, y < *cy ? *cy - y : y - *cy);
+            abAppendw(ab, y < *cy ? 'A' : 'B');
+        }
+        *cy = y;
+    }
+    if (x == *cx)
+        return;
+    if (!x || *cx >= f->xn) {
+        abAppendw(ab, '\r');
+        *cx = 0;
+    }
+    if (x != *cx) {
+        if (lowbw) {
+            bestlineMoveColumn(ab, f, y, *cx, x);
+        } else {
+            abAppends(ab, "\033[");
+            abAppendu(ab, x < *cx ? *cx - x : x - *cx);
+            abAppendw(ab, x < *cx ? 'D' : 'C');
+        }
+    }
+    *cx = x;
+}
+
+/**
+ * Updates row 𝑦 of the screen, which shows row 𝑦 of 𝑜, so it'll show
+ * row 𝑦 of 𝑛 instead.
+ *
+ * We skip cells at the beginning and end that haven't changed. If the
+ * cells in the middle changed width, then the ones after them are moved
+ * with insert or delete character, rather than being sent again.
+ */
+static void bestlineFrameDiffRow(struct abuf *ab, struct bestlineFrame *o, struct bestlineFrame *n,
+                                 unsigned y, unsigned *cy, unsigned *cx) {
+    unsigned a0, a1, b0, b1, p, s, x, wo, wn;
+    a0 = o->row[y];
+    a1 = o->row[y + 1];
+    b0 = n->row[y];
+    b1 = n->row[y + 1];
+    for (p = 0; b0 + p < b1 && a0 + p < a1 && bestlineCellEqual(o, a0 + p, n, b0 + p); ++p) {
+    }
+    if (a0 + p == a1 && b0 + p == b1)
+        return;
+    /* don't start drawing in the middle of a grapheme cluster */
+    while (p && ((b0 + p < b1 && !(n->cell[b0 + p].a & kCellHead)) ||
+                 (a0 + p < a1 && !(o->cell[a0 + p].a & kCellHead))))
+        --p;
+    for (s = 0; a0 + p + s < a1 && b0 + p + s < b1 &&
+                bestlineCellEqual(o, a1 - 1 - s, n, b1 - 1 - s);
+         ++s) {
+    }
+    while (s && !(n->cell[b1 - s].a & kCellHead))
+        --s;
+    x = bestlineFrameWidth(n, b0, b0 + p);
+    wo = bestlineFrameWidth(o, a0 + p, a1 - s);
+    wn = bestlineFrameWidth(n, b0 + p, b1 - s);
+    bestlineMoveCursor(ab, n, cy, cx, y, x);
+    if (s && wn > wo) {
+        abAppends(ab, "\033[");
+        abAppendu(ab, wn - wo);
+        abAppendw(ab, '@'); /* insert characters */
+    }
+    bestlineFrameEmit(ab, n, b0 + p, b1 - s);
+    *cx = x + wn;
+    if (s && wo > wn) {
+        abAppends(ab, "\033[");
+        abAppendu(ab, wo - wn);
+        abAppendw(ab, 'P'); /* delete characters */
+    } else if (!s && wn < wo) {
+        abAppends(ab, "\033[K"); /* clear line forward */
+    }
+}
+
+/**
+ * Generates terminal codes that turn screen 𝑜 into screen 𝑛.
+ *
+ * If 𝑜 isn't valid, then all we know is which of its rows the cursor
+ * is on, and everything gets drawn from scratch.
+ */
+static void bestlineFrameDraw(struct abuf *ab, struct bestlineFrame *o, struct bestlineFrame *n,
+                              unsigned xn) {
+    unsigned y, x;
+    if (!o->valid) {
+        abAppendw(ab, '\r'); /* start of line */
+        if (o->cy) {
+            abAppends(ab, "\033[");
+            abAppendu(ab, o->cy);
+            abAppendw(ab, 'A'); /* cursor up clamped */
+        }
+        for (x = y = 0; y < n->rows; ++y) {
+            if (y) {
+                if (x < xn)
+                    abAppends(ab, "\033[K"); /* clear line forward */
+                abAppends(ab, "\r" /* start of line */
+                              "\n"); /* cursor down unclamped */
+            }
+            x = bestlineFrameWidth(n, n->row[y], n->row[y + 1]);
+            /* erasing while a wrap is pending would erase the last cell */
+            if (y + 1 == n->rows && x >= xn)
+                abAppendw(ab, Read32le("\033[J")); /* erase display forwards */
+            bestlineFrameEmit(ab, n, n->row[y], n->row[y + 1]);
+        }
+        if (x < xn)
+            abAppendw(ab, Read32le("\033[J")); /* erase display forwards */
+        o->cy = n->rows - 1;
+        o->cx = x;
+        return;
+    }
+    for (y = 0; y < n->rows; ++y) {
+        if (y < o->rows) {
+            bestlineFrameDiffRow(ab, o, n, y, &o->cy, &o->cx);
+        } else {
+            bestlineMoveCursor(ab, n, &o->cy, &o->cx, y - 1, o->cx);
+            abAppends(ab, "\r" /* start of line */
+                          "\n"); /* cursor down unclamped */
+            bestlineFrameEmit(ab, n, n->row[y], n->row[y + 1]);
+            o->cy = y;
+            o->cx = bestlineFrameWidth(n, n->row[y], n->row[y + 1]);
+        }
+    }
+    if (o->rows > n->rows) {
+        bestlineMoveCursor(ab, o, &o->cy, &o->cx, n->rows, 0);
+        abAppendw(ab, Read32le("\033[J")); /* erase display forwards */
+    }
+}
+
+/**
+ * Returns microseconds a refresh may take while input is backed up.
+ */
+static unsigned long bestlineRenderBudget(void) {
+    return renderbudget ? renderbudget - 1 : 5000;
+}
+
+/**
+ * Returns true if refresh should skip hints and bracket highlighting.
+ *
+ * That's the case while keystrokes are backing up, if the last refresh
+ * that did everything took longer than the render budget. Everything
+ * comes back as soon as input goes idle.
+ */
+static char bestlineRefreshDegrade(struct bestlineState *l) {
+    unsigned long budget;
+    budget = bestlineRenderBudget();
+    if (!budget || l->final || l->cost <= budget || !HasPendingInput(l->ifd))
+        return 0;
+    ++degradedframes;
+    return 1;
+}
+
+static void bestlineRefreshLineImpl(struct bestlineState *l, int force) {
+    char lowbw;
+    char degraded;
     char hasflip;
+    char hasstyle;
     char haswides;
-    struct abuf ab;
+    struct abuf *ab;
     const char *buf;
     struct rune rune;
     struct winsize oldsize;
-    int fd, plen, rows, len, pos;
-    unsigned x, xn, yn, width, pwidth;
-    int i, t, cx, cy, tn, resized, flip[2];
+    struct bestlineLayout *lay;
+    struct bestlineFrame *f, tmp;
+    int plen, len, pos;
+    unsigned a, h, k, x, xn, yn, cx, cy, tn, start, width, pwidth;
+    int i, resized, flip[2];
+    unsigned long long t0;
 
     /*
      * synchonize the i/o state
@@ -2583,7 +4959,14 @@ static void bestlineRefreshLineImpl(struct bestlineState *l, int force) {
             return;
         }
     }
-    if (!force && HasPendingInput(l->ifd)) {
+    if (!bestlineFlush(l)) {
+        if (!force) {
+            l->dirty = 1; /* previous frame is still being sent */
+            return;
+        }
+        bestlineFlushAll(l);
+    }
+    if (!force && bestlineFrameDefer(l)) {
         l->dirty = 1;
         return;
     }
@@ -2592,54 +4975,50 @@ static void bestlineRefreshLineImpl(struct bestlineState *l, int force) {
         gotwinch = 0;
         l->ws = GetTerminalSize(l->ws, l->ifd, l->ofd);
     }
-    hasflip = !l->final && !bestlineEditMirror(l, flip);
+    t0 = bestlineRenderBudget() ? GetMicros() : 0;
+    lowbw = bestlineIsLowBandwidth();
+    degraded = bestlineRefreshDegrade(l);
+    hasflip = !l->final && !lowbw && !degraded && !bestlineEditMirror(l, flip);
 
-StartOver:
-    fd = l->ofd;
     buf = l->buf;
     pos = l->pos;
     len = l->len;
+    lay = &l->lay;
     xn = l->ws.ws_col;
     yn = l->ws.ws_row;
-    plen = strlen(l->prompt);
-    pwidth = GetMonospaceWidth(l->prompt, plen, 0);
-    width = GetMonospaceWidth(buf, len, &haswides);
+    plen = lay->plen;
+    pwidth = lay->pwidth;
+    if (!bestlineLayoutUpdate(l))
+        return;
+    width = lay->col[len];
+    haswides = !!lay->wides;
 
     /*
      * handle the case where the line is larger than the whole display
      * gnu readline actually isn't able to deal with this situation!!!
      * we kludge xn to address the edge case of wide chars on the edge
      */
-    for (tn = xn - haswides * 2;;) {
-        if (pwidth + width + 1 < tn * yn)
-            break; /* we're fine */
-        if (!len || width < 2)
-            break; /* we can't do anything */
-        if (pwidth + 2 > tn * yn)
-            break; /* we can't do anything */
-        if (pos > len / 2) {
-            /* hide content on the left if we're editing on the right */
-            rune = GetUtf8(buf, len);
-            buf += rune.n;
-            len -= rune.n;
-            pos -= rune.n;
-        } else {
-            /* hide content on the right if we're editing on left */
-            t = len;
-            while (len && (buf[len - 1] & 0300) == 0200)
-                --len;
-            if (len)
-                --len;
-            rune = GetUtf8(buf + len, t - len);
-        }
-        if ((t = bestlineCharacterWidth(rune.c)) > 0) {
-            width -= t;
-        }
+    tn = Max(0, (int)xn - haswides * 2) * yn;
+    if (pwidth + width + 1 >= tn && width >= 2 && pwidth + 2 <= tn) {
+        len = bestlineViewport(l, tn - pwidth - 2);
+        start = l->vstart;
+        buf += start;
+        len -= start;
+        pos -= start;
+    } else {
+        start = l->vstart = 0;
+    }
+    if (!bestlineLayoutRows(l, start, start + len, xn, pwidth))
+        return;
+    h = 0;
+    if ((hasstyle = highlightCallback && !maskmode)) {
+        if (!degraded)
+            bestlineHighlightUpdate(l);
+        h = bestlineSpanFind(&l->hl, start);
     }
-    pos = Max(0, Min(pos, len));
 
     /*
-     * now generate the terminal codes to update the line
+     * now figure out what the screen should look like
      *
      * since we support unlimited lines it's important that we don't
      * clear the screen before we draw the screen. doing that causes
@@ -2654,103 +5033,96 @@ StartOver:
      * so we can't use division based on string width to compute the
      * coordinates and have to track it as we go.
      */
-    cy = -1;
-    cx = -1;
-    rows = 1;
-    abInit(&ab);
-    abAppendw(&ab, '\r'); /* start of line */
-    if (l->rows - l->oldpos - 1 > 0) {
-        abAppends(&ab, "\033[");
-        abAppendu(&ab, l->rows - l->oldpos - 1);
-        abAppendw(&ab, 'A'); /* cursor up clamped */
-    }
-    abAppends(&ab, l->prompt);
-    x = pwidth;
-    for (i = 0; i < len; i += rune.n) {
+    f = &l->next;
+    f->rows = f->ncells = f->attrs = 0;
+    f->xn = xn;
+    if (f->text.b)
+        f->text.len = 0;
+    if (!bestlineFrameRow(f) || !bestlineFrameCell(f, l->prompt, plen, pwidth, kCellHead))
+        return;
+    for (k = 1, i = 0; i < len; i += rune.n) {
         rune = GetUtf8(buf + i, len - i);
-        if (x && x + rune.n > xn) {
-            if (cy >= 0)
-                ++cy;
-            if (x < xn) {
-                abAppends(&ab, "\033[K"); /* clear line forward */
-            }
-            abAppends(&ab, "\r" /* start of line */
-                           "\n"); /* cursor down unclamped */
-            ++rows;
-            x = 0;
+        if (k < lay->nrows && start + i == lay->row[k]) {
+            if (!bestlineFrameRow(f))
+                return;
+            ++k;
         }
-        if (i == pos) {
-            cy = 0;
-            cx = x;
+        a = IsGraphemeStart(lay, start + i) ? kCellHead : 0;
+        if (hasflip && (start + i == (unsigned)flip[0] || start + i == (unsigned)flip[1]))
+            a |= kCellBold;
+        if (hasstyle && start + i < l->hl.valid) {
+            while (h < l->hl.n && l->hl.span[h].end <= start + i)
+                ++h;
+            if (h < l->hl.n && l->hl.span[h].start <= start + i)
+                a |= l->hl.span[h].style * kCellStyle;
         }
-        if (maskmode) {
-            abAppendw(&ab, '*');
-        } else {
-            flipit = hasflip && (i == flip[0] || i == flip[1]);
-            if (flipit)
-                abAppends(&ab, "\033[1m");
-            abAppendw(&ab, EncodeUtf8(rune.c));
-            if (flipit)
-                abAppends(&ab, "\033[22m");
-        }
-        t = bestlineCharacterWidth(rune.c);
-        t = Max(0, t);
-        x += t;
-    }
-    if (!l->final && (hint = bestlineRefreshHints(l))) {
-        if (GetMonospaceWidth(hint, strlen(hint), 0) < xn - x) {
-            if (cx < 0) {
-                cx = x;
-            }
-            abAppends(&ab, hint);
-        }
-        free(hint);
+        if (!bestlineFrameCell(f, maskmode ? "*" : buf + i, maskmode ? 1 : rune.n,
+                               lay->col[start + i + rune.n] - lay->col[start + i], a))
+            return;
     }
-    abAppendw(&ab, Read32le("\033[J")); /* erase display forwards */
+    x = bestlineLayoutColumn(lay, k - 1, start + len);
+    if (pos < len) {
+        k = bestlineLayoutRow(lay, start + pos);
+        cx = bestlineLayoutColumn(lay, k, start + pos);
+        cy = k;
+    } else {
+        cx = x;
+        cy = f->rows - 1;
+    }
+    if (!l->final && !lowbw && !degraded)
+        bestlineRefreshHints(l, f, xn - x);
 
     /*
      * if we are at the very end of the screen with our prompt, we need
      * to emit a newline and move the prompt to the first column.
      */
     if (pos && pos == len && x >= xn) {
-        abAppendw(&ab, Read32le("\n\r\0"));
-        ++rows;
+        if (!bestlineFrameRow(f))
+            return;
+        cx = 0;
+        cy = f->rows - 1;
     }
+    f->row[f->rows] = f->ncells;
 
     /*
-     * move cursor to right position
+     * now generate the terminal codes to update the line
+     * we use a mostly correct kludge when the tty resizes
      */
-    if (cy > 0) {
-        abAppends(&ab, "\033[");
-        abAppendu(&ab, cy);
-        abAppendw(&ab, 'A'); /* cursor up */
-    }
-    if (cx > 0) {
-        abAppendw(&ab, Read32le("\r\033["));
-        abAppendu(&ab, cx);
-        abAppendw(&ab, 'C'); /* cursor right */
-    } else if (!cx) {
-        abAppendw(&ab, '\r'); /* start */
+    ab = &l->out;
+    abClear(ab);
+    if (syncmode && !lowbw)
+        abAppends(ab, "\033[?2026h"); /* begin synchronized update */
+    k = ab->len;
+    if (resized || l->shown.xn != xn)
+        l->shown.valid = 0;
+    if (resized && oldsize.ws_col > l->ws.ws_col)
+        l->shown.cy = Max(0, (int)l->shown.cy + (int)f->rows - (int)l->shown.rows);
+    bestlineFrameDraw(ab, &l->shown, f, xn);
+    bestlineMoveCursor(ab, f, &l->shown.cy, &l->shown.cx, cy, cx);
+    if (ab->len - k < 64) {
+        /* a tiny update gets drawn all at once anyway */
+        memmove(ab->b, ab->b + k, ab->len - k);
+        ab->len -= k;
+    } else if (syncmode && !lowbw) {
+        abAppends(ab, "\033[?2026l"); /* end synchronized update */
     }
 
     /*
      * now get ready to progress state
-     * we use a mostly correct kludge when the tty resizes
      */
-    l->rows = rows;
-    if (resized && oldsize.ws_col > l->ws.ws_col) {
-        resized = 0;
-        abFree(&ab);
-        goto StartOver;
-    }
-    l->dirty = 0;
-    l->oldpos = Max(0, cy);
+    tmp = l->shown;
+    l->shown = l->next;
+    l->next = tmp;
+    l->shown.xn = xn;
+    l->shown.cy = l->next.cy;
+    l->shown.cx = l->next.cx;
 
     /*
      * send codes to terminal
      */
-    bestlineWrite(fd, ab.b, ab.len);
-    abFree(&ab);
+    bestlineFrameSend(l);
+    if (bestlineRenderBudget() && !degraded)
+        l->cost = GetMicros() - t0;
 }
 
 static void bestlineRefreshLine(struct bestlineState *l) {
@@ -2761,25 +5133,283 @@ static void bestlineRefreshLineForce(struct bestlineState *l) {
     bestlineRefreshLineImpl(l, 1);
 }
 
+/**
+ * Checks if the screen can be updated without a full refresh.
+ *
+ * That's the case when the screen is known to show the whole line as
+ * it was last laid out, and no brackets are highlighted. On success the
+ * layout rows are brought up to date for the current line.
+ */
+static char bestlineRefreshFast(struct bestlineState *l) {
+    int tn, flip[2];
+    struct bestlineLayout *y = &l->lay;
+    if (ispaused || gotwinch || l->dirty || l->final || !l->shown.valid ||
+        l->sent < l->out.len || l->shown.xn != l->ws.ws_col || (l->shown.attrs & kCellBold))
+        return 0;
+    if (!bestlineLayoutUpdate(l))
+        return 0;
+    tn = l->ws.ws_col - !!y->wides * 2;
+    if (y->pwidth + y->col[l->len] + 1 >= (unsigned)Max(0, tn) * l->ws.ws_row)
+        return 0; /* line is trimmed to fit the display */
+    if (!bestlineLayoutRows(l, 0, l->len, l->ws.ws_col, y->pwidth))
+        return 0;
+    if (bestlineLayoutColumn(y, y->nrows - 1, l->len) >= l->ws.ws_col)
+        return 0; /* there might be a pending wrap or an extra row */
+    if (y->nrows != l->shown.rows)
+        return 0;
+    if (!bestlineIsLowBandwidth() && !bestlineEditMirror(l, flip))
+        return 0; /* a bracket needs to be highlighted */
+    return 1;
+}
+
+/**
+ * Sends codes to terminal that were generated by a fast refresh.
+ */
+static void bestlineRefreshSend(struct bestlineState *l) {
+    struct bestlineLayout *y = &l->lay;
+    unsigned k = bestlineLayoutRow(y, l->pos);
+    bestlineMoveCursor(&l->out, &l->shown, &l->shown.cy, &l->shown.cx, k,
+                       bestlineLayoutColumn(y, k, l->pos));
+    bestlineFrameSend(l);
+}
+
+/**
+ * Refreshes line after cursor moved but the text is the same.
+ *
+ * Hints only depend on the text, so the one on screen stays put.
+ */
+static void bestlineRefreshCursor(struct bestlineState *l) {
+    if (!bestlineRefreshFast(l)) {
+        bestlineRefreshLine(l);
+    } else if (bestlineFrameDefer(l)) {
+        l->dirty = 1;
+    } else {
+        abClear(&l->out);
+        bestlineRefreshSend(l);
+    }
+}
+
+/**
+ * Refreshes line after buf[i,len) was typed at the end of the line.
+ *
+ * The new runes are drawn after the old ones, provided they all fit on
+ * the last row, start a new grapheme cluster, and no hint could change.
+ */
+static void bestlineRefreshAppend(struct bestlineState *l, unsigned i) {
+    struct rune r;
+    unsigned j, k, w;
+    struct bestlineFrame *f = &l->shown;
+    if (((hintsCallback || asyncHintsCallback) && !bestlineIsLowBandwidth()) ||
+        (highlightCallback && !maskmode) || (f->attrs & kCellHint) ||
+        !bestlineRefreshFast(l) ||
+        !IsGraphemeStart(&l->lay, i)) {
+        bestlineRefreshLine(l);
+        return;
+    }
+    if (bestlineFrameDefer(l)) {
+        l->dirty = 1;
+        return;
+    }
+    k = f->ncells;
+    for (j = i; j < l->len; j += r.n) {
+        r = GetUtf8(l->buf + j, l->len - j);
+        w = l->lay.col[j + r.n] - l->lay.col[j];
+        if (!bestlineFrameCell(f, maskmode ? "*" : l->buf + j, maskmode ? 1 : r.n, w,
+                               IsGraphemeStart(&l->lay, j) ? kCellHead : 0)) {
+            f->valid = 0;
+            bestlineRefreshLine(l);
+            return;
+        }
+    }
+    f->row[f->rows] = f->ncells;
+    abClear(&l->out);
+    bestlineMoveCursor(&l->out, f, &f->cy, &f->cx, f->rows - 1,
+                       bestlineLayoutColumn(&l->lay, f->rows - 1, i));
+    bestlineFrameEmit(&l->out, f, k, f->ncells);
+    f->cx += bestlineFrameWidth(f, k, f->ncells);
+    bestlineRefreshSend(l);
+}
+
+/**
+ * Inserts text at cursor without refreshing. Returns bytes inserted.
+ */
+static size_t bestlineInsert(struct bestlineState *l, const char *p, size_t n) {
+    char *q = 0;
+    if (SkipUtf8(p, n) < n) {
+        if (!(q = CopyUtf8(p, &n)))
+            return 0;
+        p = q;
+    }
+    if (bestlineGrow(l, l->len + n + 1)) {
+        bestlineLayoutInvalidate(l, l->pos);
+        memmove(l->buf + l->pos + n, l->buf + l->pos, l->len - l->pos);
+        memcpy(l->buf + l->pos, p, n);
+        l->pos += n;
+        l->len += n;
+        l->buf[l->len] = 0;
+    } else {
+        n = 0;
+    }
+    free(q);
+    return n;
+}
+
 static void bestlineEditInsert(struct bestlineState *l, const char *p, size_t n) {
-    if (!bestlineGrow(l, l->len + n + 1))
+    if (!(n = bestlineInsert(l, p, n)))
         return;
-    memmove(l->buf + l->pos + n, l->buf + l->pos, l->len - l->pos);
-    memcpy(l->buf + l->pos, p, n);
-    l->pos += n;
-    l->len += n;
-    l->buf[l->len] = 0;
-    bestlineRefreshLine(l);
+    if (l->pos == l->len) {
+        bestlineRefreshAppend(l, l->len - n);
+    } else {
+        bestlineRefreshLine(l);
+    }
+}
+
+/**
+ * Moves on to a continuation line, keeping what's been typed so far.
+ */
+static void bestlineEditContinue(struct bestlineState *l) {
+    bestlineSetPrompt(l, "... ");
+    abAppends(&l->full, "\n");
+    l->len = 0;
+    l->pos = 0;
+    bestlineLayoutInvalidate(l, 0);
+    bestlineWriteStr(l->ofd, "\r\n");
+    bestlineFrameReset(l);
+    bestlineRefreshLineForce(l);
+}
+
+/**
+ * Reads bracketed paste up to its end marker, into 𝑎.
+ */
+static void bestlineReadPaste(struct bestlineState *l, struct abuf *a) {
+    int rc;
+    unsigned char c;
+    for (;;) {
+        if ((rc = ReadByte(l->ifd, &c)) == 1) {
+            abAppend(a, (char *)&c, 1);
+            if (a->len >= 6 && !memcmp(a->b + a->len - 6, "\033[201~", 6)) {
+                a->len -= 6;
+                break;
+            }
+        } else if (rc == -1 && errno == EINTR && !gotint) {
+            continue;
+        } else if (rc == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (WaitUntilReady(l->ifd, POLLIN) == -1 && errno != EINTR)
+                break;
+        } else {
+            break;
+        }
+    }
+}
+
+/**
+ * Reads rest of a paste that arrived without brackets, into 𝑎.
+ *
+ * Bytes are taken for as long as they keep coming, up to the next
+ * escape sequence, which is left to be read as a keystroke.
+ */
+static void bestlineReadBurst(struct bestlineState *l, struct abuf *a) {
+    char *p;
+    struct bestlineReadAhead *r;
+    while ((r = GetReadAhead(l->ifd))) {
+        if (r->i == r->n && (_MyPoll(l->ifd, POLLIN, 10) != 1 || FillReadAhead(r, l->ifd) <= 0))
+            break;
+        p = (char *)memchr(r->b + r->i, 033, r->n - r->i);
+        abAppend(a, r->b + r->i, (p ? p - r->b : r->n) - r->i);
+        if (p) {
+            r->i = p - r->b;
+            break;
+        }
+        r->i = r->n;
+    }
+}
+
+/**
+ * Inserts pasted text 𝑎, which is used as scratch space afterwards.
+ *
+ * The paste is inserted all at once, rather than being fed through the
+ * keymap a byte at a time. Control codes are dropped, like they would
+ * be if typed, and each line break starts a continuation line, so the
+ * line isn't submitted until enter is pressed. Lines between the first
+ * and last are written out in one go.
+ *
+ * The paste hasn't been through the UTF-8 state machine, so it's framed
+ * with ScanUtf8() here and ill-formed bytes become U+FFFD before any
+ * line breaks or control codes are looked for.
+ */
+static void bestlineEditPaste(struct bestlineState *l, struct abuf *a) {
+    int k;
+    char *p, *q, *e;
+    size_t i;
+    struct rune r;
+    struct abuf b;
+    abInit(&b);
+    for (i = 0; i < a->len; i += r.n) {
+        if ((k = ScanUtf8(a->b + i, a->len - i)) > 0) {
+            r = GetUtf8(a->b + i, k);
+        } else {
+            r.c = 0xFFFD; /* replaces maximal subpart */
+            r.n = -k;
+        }
+        if (r.c == '\r') {
+            if (i + 1 < a->len && a->b[i + 1] == '\n')
+                continue;
+            r.c = '\n';
+        }
+        if (r.c != '\n') {
+            if (IsControl(r.c))
+                continue;
+            if (xlatCallback)
+                r.c = xlatCallback(r.c);
+        }
+        abAppendw(&b, EncodeUtf8(r.c));
+    }
+    p = b.b;
+    e = b.b + b.len;
+    if ((q = (char *)memchr(p, '\n', e - p))) {
+        bestlineInsert(l, p, q - p);
+        l->pos = l->len;
+        l->final = 1;
+        bestlineRefreshLineForce(l);
+        l->final = 0;
+        abAppend(&l->full, l->buf, l->len);
+        abClear(a);
+        for (p = q + 1; (q = (char *)memchr(p, '\n', e - p)); p = q + 1) {
+            abAppends(&l->full, "\n");
+            abAppend(&l->full, p, q - p);
+            abAppends(a, "\r\n... ");
+            if (maskmode) {
+                for (; p < q; ++p)
+                    if ((*p & 0300) != 0200)
+                        abAppendw(a, '*');
+            } else {
+                abAppend(a, p, q - p);
+            }
+        }
+        abAppends(&l->full, "\n");
+        abAppends(a, "\r\n");
+        bestlineWrite(l->ofd, a->b, a->len);
+        bestlineSetPrompt(l, "... ");
+        l->len = 0;
+        l->pos = 0;
+        bestlineLayoutInvalidate(l, 0);
+        bestlineFrameReset(l);
+        bestlineInsert(l, p, e - p);
+        bestlineRefreshLineForce(l);
+    } else if (bestlineInsert(l, p, e - p)) {
+        bestlineRefreshLine(l);
+    }
+    abFree(&b);
 }
 
 static void bestlineEditHome(struct bestlineState *l) {
     l->pos = 0;
-    bestlineRefreshLine(l);
+    bestlineRefreshCursor(l);
 }
 
 static void bestlineEditEnd(struct bestlineState *l) {
     l->pos = l->len;
-    bestlineRefreshLine(l);
+    bestlineRefreshCursor(l);
 }
 
 static void bestlineEditUp(struct bestlineState *l) {
@@ -2799,21 +5429,26 @@ static void bestlineEditEof(struct bestlineState *l) {
 }
 
 static void bestlineEditRefresh(struct bestlineState *l) {
+    l->sent = l->out.len; /* no point finishing a frame we're erasing */
     bestlineClearScreen(l->ofd);
+    bestlineFrameReset(l);
     bestlineRefreshLine(l);
 }
 
-static size_t Forward(struct bestlineState *l, size_t pos) {
-    return pos + GetUtf8(l->buf + pos, l->len - pos).n;
-}
-
-static size_t Backwards(struct bestlineState *l, size_t pos, char pred(unsigned)) {
+/**
+ * Moves backwards over clusters whose class is in 𝑚𝑎𝑠𝑘.
+ */
+static size_t Backwards(struct bestlineState *l, size_t pos, unsigned mask) {
+    long j;
     size_t i;
-    struct rune r;
+    if (bestlineLayoutUpdate(l)) {
+        if ((j = PrevRun(&l->lay, pos, kRunAll & ~mask)) == -1)
+            return 0;
+        return Min(NextRun(&l->lay, j + 1, kRunAll), pos);
+    }
     while (pos) {
         i = Backward(l, pos);
-        r = GetUtf8(l->buf + i, l->len - i);
-        if (pred(r.c)) {
+        if (mask >> GetRunClass(GetUtf8(l->buf + i, l->len - i).c) & 1) {
             pos = i;
         } else {
             break;
@@ -2822,12 +5457,17 @@ static size_t Backwards(struct bestlineState *l, size_t pos, char pred(unsigned)
     return pos;
 }
 
-static size_t Forwards(struct bestlineState *l, size_t pos, char pred(unsigned)) {
-    struct rune r;
+/**
+ * Moves forwards over clusters whose class is in 𝑚𝑎𝑠𝑘.
+ */
+static size_t Forwards(struct bestlineState *l, size_t pos, unsigned mask) {
+    char indexed;
+    indexed = bestlineLayoutUpdate(l);
     while (pos < l->len) {
-        r = GetUtf8(l->buf + pos, l->len - pos);
-        if (pred(r.c)) {
-            pos += r.n;
+        if (indexed && IsGraphemeStart(&l->lay, pos))
+            return NextRun(&l->lay, pos, kRunAll & ~mask);
+        if (mask >> GetRunClass(GetUtf8(l->buf + pos, l->len - pos).c) & 1) {
+            pos = Forward(l, pos);
         } else {
             break;
         }
@@ -2836,50 +5476,39 @@ static size_t Forwards(struct bestlineState *l, size_t pos, char pred(unsigned))
 }
 
 static size_t ForwardWord(struct bestlineState *l, size_t pos) {
-    pos = Forwards(l, pos, bestlineIsSeparator);
-    pos = Forwards(l, pos, bestlineNotSeparator);
+    pos = Forwards(l, pos, kRunSeparator);
+    pos = Forwards(l, pos, 1 << kRunWord);
     return pos;
 }
 
 static size_t BackwardWord(struct bestlineState *l, size_t pos) {
-    pos = Backwards(l, pos, bestlineIsSeparator);
-    pos = Backwards(l, pos, bestlineNotSeparator);
+    pos = Backwards(l, pos, kRunSeparator);
+    pos = Backwards(l, pos, 1 << kRunWord);
     return pos;
 }
 
 static size_t EscapeWord(struct bestlineState *l, size_t i) {
     size_t j;
     struct rune r;
-    for (; i && i < l->len; i += r.n) {
-        if (i < l->len) {
-            r = GetUtf8(l->buf + i, l->len - i);
-            if (bestlineIsSeparator(r.c))
-                break;
-        }
-        if ((j = i)) {
-            do
-                --j;
-            while (j && (l->buf[j] & 0300) == 0200);
-            r = GetUtf8(l->buf + j, l->len - j);
-            if (bestlineIsSeparator(r.c))
-                break;
-        }
-    }
-    return i;
+    if (!i || i == l->len)
+        return i;
+    j = Backward(l, i);
+    r = GetUtf8(l->buf + j, l->len - j);
+    if (bestlineIsSeparator(r.c))
+        return i;
+    return Forwards(l, i, 1 << kRunWord);
 }
 
 static void bestlineEditLeft(struct bestlineState *l) {
     l->pos = Backward(l, l->pos);
-    bestlineRefreshLine(l);
+    bestlineRefreshCursor(l);
 }
 
 static void bestlineEditRight(struct bestlineState *l) {
     if (l->pos == l->len)
         return;
-    do
-        l->pos++;
-    while (l->pos < l->len && (l->buf[l->pos] & 0300) == 0200);
-    bestlineRefreshLine(l);
+    l->pos = Forward(l, l->pos);
+    bestlineRefreshCursor(l);
 }
 
 static void bestlineEditLeftWord(struct bestlineState *l) {
@@ -2894,22 +5523,22 @@ static void bestlineEditRightWord(struct bestlineState *l) {
 
 static void bestlineEditLeftExpr(struct bestlineState *l) {
     int mark[2];
-    l->pos = Backwards(l, l->pos, bestlineIsXeparator);
+    l->pos = Backwards(l, l->pos, 1 << kRunSpace);
     if (!bestlineEditMirrorLeft(l, mark)) {
         l->pos = mark[0];
     } else {
-        l->pos = Backwards(l, l->pos, bestlineNotSeparator);
+        l->pos = Backwards(l, l->pos, 1 << kRunWord);
     }
     bestlineRefreshLine(l);
 }
 
 static void bestlineEditRightExpr(struct bestlineState *l) {
     int mark[2];
-    l->pos = Forwards(l, l->pos, bestlineIsXeparator);
+    l->pos = Forwards(l, l->pos, 1 << kRunSpace);
     if (!bestlineEditMirrorRight(l, mark)) {
         l->pos = Forward(l, mark[1]);
     } else {
-        l->pos = Forwards(l, l->pos, bestlineNotSeparator);
+        l->pos = Forwards(l, l->pos, 1 << kRunWord);
     }
     bestlineRefreshLine(l);
 }
@@ -2921,6 +5550,7 @@ static void bestlineEditDelete(struct bestlineState *l) {
     i = Forward(l, l->pos);
     memmove(l->buf + l->pos, l->buf + i, l->len - i + 1);
     l->len -= i - l->pos;
+    bestlineLayoutInvalidate(l, l->pos);
     bestlineRefreshLine(l);
 }
 
@@ -2932,6 +5562,7 @@ static void bestlineEditRubout(struct bestlineState *l) {
     memmove(l->buf + i, l->buf + l->pos, l->len - l->pos + 1);
     l->len -= l->pos - i;
     l->pos = i;
+    bestlineLayoutInvalidate(l, i);
     bestlineRefreshLine(l);
 }
 
@@ -2943,6 +5574,7 @@ static void bestlineEditDeleteWord(struct bestlineState *l) {
     bestlineRingPush(l->buf + l->pos, i - l->pos);
     memmove(l->buf + l->pos, l->buf + i, l->len - i + 1);
     l->len -= i - l->pos;
+    bestlineLayoutInvalidate(l, l->pos);
     bestlineRefreshLine(l);
 }
 
@@ -2955,24 +5587,28 @@ static void bestlineEditRuboutWord(struct bestlineState *l) {
     memmove(l->buf + i, l->buf + l->pos, l->len - l->pos + 1);
     l->len -= l->pos - i;
     l->pos = i;
+    bestlineLayoutInvalidate(l, i);
     bestlineRefreshLine(l);
 }
 
 static void bestlineEditXlatWord(struct bestlineState *l, unsigned xlat(unsigned)) {
     unsigned c;
-    size_t i, j;
+    size_t i, j, k;
     struct rune r;
     struct abuf ab;
     abInit(&ab);
-    i = Forwards(l, l->pos, bestlineIsSeparator);
-    for (j = i; j < l->len; j += r.n) {
+    i = Forwards(l, l->pos, kRunSeparator);
+    for (j = i; j < l->len; j = k) {
         r = GetUtf8(l->buf + j, l->len - j);
         if (bestlineIsSeparator(r.c))
             break;
-        if ((c = xlat(r.c)) != r.c) {
-            abAppendw(&ab, EncodeUtf8(c));
-        } else { /* avoid canonicalization */
-            abAppend(&ab, l->buf + j, r.n);
+        for (k = Forward(l, j); j < k; j += r.n) {
+            r = GetUtf8(l->buf + j, l->len - j);
+            if ((c = xlat(r.c)) != r.c) {
+                abAppendw(&ab, EncodeUtf8(c));
+            } else { /* avoid canonicalization */
+                abAppend(&ab, l->buf + j, r.n);
+            }
         }
     }
     if (ab.len && bestlineGrow(l, i + ab.len + l->len - j + 1)) {
@@ -2980,6 +5616,7 @@ static void bestlineEditXlatWord(struct bestlineState *l, unsigned xlat(unsigned
         abAppend(&ab, l->buf + j, l->len - j);
         l->len = i + ab.len;
         memcpy(l->buf + i, ab.b, ab.len + 1);
+        bestlineLayoutInvalidate(l, i);
         bestlineRefreshLine(l);
     }
     abFree(&ab);
@@ -3006,6 +5643,7 @@ static void bestlineEditKillLeft(struct bestlineState *l) {
     diff = old_pos - l->pos;
     memmove(l->buf + l->pos, l->buf + old_pos, l->len - old_pos + 1);
     l->len -= diff;
+    bestlineLayoutInvalidate(l, 0);
     bestlineRefreshLine(l);
 }
 
@@ -3013,6 +5651,7 @@ static void bestlineEditKillRight(struct bestlineState *l) {
     bestlineRingPush(l->buf + l->pos, l->len - l->pos);
     l->buf[l->pos] = '\0';
     l->len = l->pos;
+    bestlineLayoutInvalidate(l, l->pos);
     bestlineRefreshLine(l);
 }
 
@@ -3032,17 +5671,19 @@ static void bestlineEditYank(struct bestlineState *l) {
     free(p);
     l->yi = l->pos;
     l->yj = l->pos + n;
+    bestlineLayoutInvalidate(l, l->pos);
     l->pos += n;
     l->len += n;
     bestlineRefreshLine(l);
 }
 
 static void bestlineEditRotate(struct bestlineState *l) {
-    if ((l->seq[1][0] == Ctrl('Y') || (l->seq[1][0] == 033 && l->seq[1][1] == 'y'))) {
+    if (l->lastcmd == BESTLINE_CMD_YANK || l->lastcmd == BESTLINE_CMD_ROTATE) {
         if (l->yi < l->len && l->yj <= l->len) {
             memmove(l->buf + l->yi, l->buf + l->yj, l->len - l->yj + 1);
             l->len -= l->yj - l->yi;
             l->pos -= l->yj - l->yi;
+            bestlineLayoutInvalidate(l, l->yi);
         }
         bestlineRingRotate();
         bestlineEditYank(l);
@@ -3054,7 +5695,7 @@ static void bestlineEditTranspose(struct bestlineState *l) {
     size_t a, b, c;
     b = l->pos;
     if (b == l->len)
-        --b;
+        b = Backward(l, b);
     a = Backward(l, b);
     c = Forward(l, b);
     if (!(a < b && b < c))
@@ -3066,6 +5707,7 @@ static void bestlineEditTranspose(struct bestlineState *l) {
     memcpy(l->buf + a, q, p - q);
     l->pos = c;
     free(q);
+    bestlineLayoutInvalidate(l, a);
     bestlineRefreshLine(l);
 }
 
@@ -3074,14 +5716,14 @@ static void bestlineEditTransposeWords(struct bestlineState *l) {
     size_t i, pi, xi, xj, yi, yj;
     i = l->pos;
     if (i == l->len) {
-        i = Backwards(l, i, bestlineIsSeparator);
-        i = Backwards(l, i, bestlineNotSeparator);
+        i = Backwards(l, i, kRunSeparator);
+        i = Backwards(l, i, 1 << kRunWord);
     }
     pi = EscapeWord(l, i);
-    xj = Backwards(l, pi, bestlineIsSeparator);
-    xi = Backwards(l, xj, bestlineNotSeparator);
-    yi = Forwards(l, pi, bestlineIsSeparator);
-    yj = Forwards(l, yi, bestlineNotSeparator);
+    xj = Backwards(l, pi, kRunSeparator);
+    xi = Backwards(l, xj, 1 << kRunWord);
+    yi = Forwards(l, pi, kRunSeparator);
+    yj = Forwards(l, yi, 1 << kRunWord);
     if (!(xi < xj && xj < yi && yi < yj))
         return;
     p = q = (char *)malloc(yj - xi);
@@ -3092,18 +5734,20 @@ static void bestlineEditTransposeWords(struct bestlineState *l) {
     memcpy(l->buf + xi, q, p - q);
     l->pos = yj;
     free(q);
+    bestlineLayoutInvalidate(l, xi);
     bestlineRefreshLine(l);
 }
 
 static void bestlineEditSqueeze(struct bestlineState *l) {
     size_t i, j;
-    i = Backwards(l, l->pos, bestlineIsSeparator);
-    j = Forwards(l, l->pos, bestlineIsSeparator);
+    i = Backwards(l, l->pos, kRunSeparator);
+    j = Forwards(l, l->pos, kRunSeparator);
     if (!(i < j))
         return;
     memmove(l->buf + i, l->buf + j, l->len - j + 1);
     l->len -= j - i;
     l->pos = i;
+    bestlineLayoutInvalidate(l, i);
     bestlineRefreshLine(l);
 }
 
@@ -3165,15 +5809,18 @@ static void bestlineEditInsertEscape(struct bestlineState *l) {
     }
 }
 
-static void bestlineEditInterrupt(void) {
+static void bestlineEditInterrupt(struct bestlineState *l) {
+    (void)l;
     gotint = SIGINT;
 }
 
-static void bestlineEditQuit(void) {
+static void bestlineEditQuit(struct bestlineState *l) {
+    (void)l;
     gotint = SIGQUIT;
 }
 
-static void bestlineEditSuspend(void) {
+static void bestlineEditSuspend(struct bestlineState *l) {
+    (void)l;
     raise(SIGSTOP);
 }
 
@@ -3234,7 +5881,7 @@ static void bestlineEditBarf(struct bestlineState *l) {
         }
     }
     /* go back one item */
-    pos = Backwards(l, pos, bestlineIsXeparator);
+    pos = Backwards(l, pos, 1 << kRunSpace);
     for (;; pos = i) {
         if (!pos)
             goto Finish;
@@ -3253,7 +5900,7 @@ static void bestlineEditBarf(struct bestlineState *l) {
             }
         }
     }
-    pos = Backwards(l, pos, bestlineIsXeparator);
+    pos = Backwards(l, pos, 1 << kRunSpace);
     /* now move the text */
     r = GetUtf8(l->buf + end, l->len - end);
     memmove(l->buf + pos + r.n, l->buf + pos, end - pos);
@@ -3265,6 +5912,7 @@ static void bestlineEditBarf(struct bestlineState *l) {
     if (l->pos > pos) {
         l->pos += r.n;
     }
+    bestlineLayoutInvalidate(l, pos);
     bestlineRefreshLine(l);
 Finish:
     free(stack);
@@ -3307,44 +5955,371 @@ static void bestlineEditSlurp(struct bestlineState *l) {
             }
         }
     }
-    /* go forward one item */
-    pos = Forwards(l, pos, bestlineIsXeparator);
-    for (; pos < l->len; pos += r.n) {
-        r = GetUtf8(l->buf + pos, l->len - pos);
-        if (depth) {
-            if (r.c == stack[depth - 1]) {
-                --depth;
-            }
-        } else {
-            if ((rhs = bestlineMirrorRight(r.c))) {
-                stack = (unsigned *)realloc(stack, ++depth * sizeof(*stack));
-                stack[depth - 1] = rhs;
-            } else if (bestlineIsSeparator(r.c)) {
-                break;
+    /* go forward one item */
+    pos = Forwards(l, pos, 1 << kRunSpace);
+    for (; pos < l->len; pos += r.n) {
+        r = GetUtf8(l->buf + pos, l->len - pos);
+        if (depth) {
+            if (r.c == stack[depth - 1]) {
+                --depth;
+            }
+        } else {
+            if ((rhs = bestlineMirrorRight(r.c))) {
+                stack = (unsigned *)realloc(stack, ++depth * sizeof(*stack));
+                stack[depth - 1] = rhs;
+            } else if (bestlineIsSeparator(r.c)) {
+                break;
+            }
+        }
+    }
+    /* now move the text */
+    memcpy(rp, l->buf + point, start - point);
+    memmove(l->buf + point, l->buf + start, pos - start);
+    memcpy(l->buf + pos - (start - point), rp, start - point);
+    bestlineLayoutInvalidate(l, point);
+    bestlineRefreshLine(l);
+    free(stack);
+}
+
+static void bestlineEditRaise(struct bestlineState *l) {
+    (void)l;
+}
+
+static char IsBalanced(struct abuf *buf) {
+    unsigned i, d;
+    for (d = i = 0; i < buf->len; ++i) {
+        if (buf->b[i] == '(')
+            ++d;
+        else if (d > 0 && buf->b[i] == ')')
+            --d;
+    }
+    return d == 0;
+}
+
+static void bestlineEditNothing(struct bestlineState *l) {
+    (void)l;
+}
+
+static void bestlineEditSelfInsert(struct bestlineState *l) {
+    size_t n;
+    char seq[8];
+    struct abuf paste;
+    unsigned long long w;
+    if (IsControl(l->key.key) || l->key.key >= BESTLINE_KEY_UP) {
+        /* only sees canonical c0 */
+    } else if (IsPasteBurst(l->ifd)) {
+        abInit(&paste);
+        abAppends(&paste, l->key.text);
+        bestlineReadBurst(l, &paste);
+        bestlineEditPaste(l, &paste);
+        abFree(&paste);
+    } else if (xlatCallback) {
+        w = EncodeUtf8(xlatCallback(l->key.key));
+        n = 0;
+        do {
+            seq[n++] = w;
+        } while ((w >>= 8));
+        bestlineEditInsert(l, seq, n);
+    } else {
+        bestlineEditInsert(l, l->key.text, strlen(l->key.text));
+    }
+}
+
+static void bestlineEditBracketedPaste(struct bestlineState *l) {
+    struct abuf paste;
+    abInit(&paste);
+    bestlineReadPaste(l, &paste);
+    bestlineEditPaste(l, &paste);
+    abFree(&paste);
+}
+
+static void bestlineEditNewline(struct bestlineState *l) {
+    l->final = 1;
+    bestlineEditEnd(l);
+    bestlineRefreshLineForce(l);
+    l->final = 0;
+    abAppend(&l->full, l->buf, l->len);
+    bestlineEditContinue(l);
+}
+
+static void bestlineEditAccept(struct bestlineState *l) {
+    char finished = 1;
+    if (historylen) {
+        free(history[--historylen]);
+        history[historylen] = 0;
+    }
+    l->final = 1;
+    bestlineEditEnd(l);
+    bestlineRefreshLineForce(l);
+    l->final = 0;
+    abAppend(&l->full, l->buf, l->len);
+    if (balancemode)
+        if (!IsBalanced(&l->full))
+            finished = 0;
+    if (llamamode)
+        if (StartsWith(l->full.b, "\"\"\""))
+            finished = l->full.len > 6 && EndsWith(l->full.b, "\"\"\"");
+    if (finished) {
+        l->done = 1;
+    } else {
+        bestlineEditContinue(l);
+    }
+}
+
+static void bestlineEditDeleteOrEof(struct bestlineState *l) {
+    if (l->len) {
+        bestlineEditDelete(l);
+    } else {
+        l->done = -1;
+    }
+}
+
+static void bestlineEditSearch(struct bestlineState *l) {
+    int rc;
+    char seq[16];
+    if ((rc = bestlineSearch(l, seq, sizeof(seq))) > 0) {
+        l->again = 1;
+    } else if (rc) {
+        l->done = -1;
+    }
+}
+
+static void bestlineEditComplete(struct bestlineState *l) {
+    ssize_t rc;
+    char seq[16];
+    if (!completionCallback)
+        return;
+    if ((rc = bestlineCompleteLine(l, seq, sizeof(seq))) > 0) {
+        l->again = 1;
+    } else if (rc) {
+        l->done = -1;
+    }
+}
+
+/* indexed by enum bestlineCommands */
+static void (*const kCommands[])(struct bestlineState *) = {
+    bestlineEditNothing,
+    bestlineEditSelfInsert,
+    bestlineEditAccept,
+    bestlineEditNewline,
+    bestlineEditDeleteOrEof,
+    bestlineEditBracketedPaste,
+    bestlineEditSearch,
+    bestlineEditComplete,
+    bestlineEditUp,
+    bestlineEditDown,
+    bestlineEditLeft,
+    bestlineEditRight,
+    bestlineEditHome,
+    bestlineEditEnd,
+    bestlineEditBof,
+    bestlineEditEof,
+    bestlineEditLeftWord,
+    bestlineEditRightWord,
+    bestlineEditLeftExpr,
+    bestlineEditRightExpr,
+    bestlineEditDelete,
+    bestlineEditRubout,
+    bestlineEditDeleteWord,
+    bestlineEditRuboutWord,
+    bestlineEditLowercaseWord,
+    bestlineEditUppercaseWord,
+    bestlineEditCapitalizeWord,
+    bestlineEditKillLeft,
+    bestlineEditKillRight,
+    bestlineEditYank,
+    bestlineEditRotate,
+    bestlineEditTranspose,
+    bestlineEditTransposeWords,
+    bestlineEditSqueeze,
+    bestlineEditMark,
+    bestlineEditGoto,
+    bestlineEditBarf,
+    bestlineEditSlurp,
+    bestlineEditRaise,
+    bestlineEditRefresh,
+    bestlineEditPause,
+    bestlineEditCtrlq,
+    bestlineEditInterrupt,
+    bestlineEditQuit,
+    bestlineEditSuspend,
+};
+
+#define kBuiltinCommands (sizeof(kCommands) / sizeof(*kCommands))
+
+static const struct bestlineBinding {
+    unsigned char map;
+    unsigned char mods;
+    unsigned key;
+    unsigned short cmd;
+} kBindings[] = {
+    {0, 0, '\r', BESTLINE_CMD_ACCEPT},
+    {0, 0, '\n', BESTLINE_CMD_NEWLINE},
+    {0, 0, '\t', BESTLINE_CMD_COMPLETE},
+    {0, 0, Ctrl('R'), BESTLINE_CMD_SEARCH},
+    {0, 0, Ctrl('P'), BESTLINE_CMD_UP},
+    {0, 0, Ctrl('E'), BESTLINE_CMD_END},
+    {0, 0, Ctrl('N'), BESTLINE_CMD_DOWN},
+    {0, 0, Ctrl('A'), BESTLINE_CMD_HOME},
+    {0, 0, Ctrl('B'), BESTLINE_CMD_LEFT},
+    {0, 0, Ctrl('@'), BESTLINE_CMD_MARK},
+    {0, 0, Ctrl('Y'), BESTLINE_CMD_YANK},
+    {0, 0, Ctrl('Q'), BESTLINE_CMD_QUOTE},
+    {0, 0, Ctrl('F'), BESTLINE_CMD_RIGHT},
+    {0, 0, Ctrl('\\'), BESTLINE_CMD_QUIT},
+    {0, 0, Ctrl('S'), BESTLINE_CMD_PAUSE},
+    {0, 0, Ctrl('?'), BESTLINE_CMD_RUBOUT},
+    {0, 0, Ctrl('H'), BESTLINE_CMD_RUBOUT},
+    {0, 0, Ctrl('L'), BESTLINE_CMD_REFRESH},
+    {0, 0, Ctrl('Z'), BESTLINE_CMD_SUSPEND},
+    {0, 0, Ctrl('U'), BESTLINE_CMD_KILL_LEFT},
+    {0, 0, Ctrl('T'), BESTLINE_CMD_TRANSPOSE},
+    {0, 0, Ctrl('K'), BESTLINE_CMD_KILL_RIGHT},
+    {0, 0, Ctrl('W'), BESTLINE_CMD_RUBOUT_WORD},
+    {0, 0, Ctrl('D'), BESTLINE_CMD_DELETE_OR_EOF},
+    {0, 0, Ctrl('X'), kKeymapPrefix | kKeymapCtrlX},
+    {0, 0, BESTLINE_KEY_UP, BESTLINE_CMD_UP},
+    {0, 0, BESTLINE_KEY_DOWN, BESTLINE_CMD_DOWN},
+    {0, 0, BESTLINE_KEY_RIGHT, BESTLINE_CMD_RIGHT},
+    {0, 0, BESTLINE_KEY_LEFT, BESTLINE_CMD_LEFT},
+    {0, 0, BESTLINE_KEY_HOME, BESTLINE_CMD_HOME},
+    {0, 0, BESTLINE_KEY_END, BESTLINE_CMD_END},
+    {0, 0, BESTLINE_KEY_DELETE, BESTLINE_CMD_DELETE},
+    {0, 0, BESTLINE_KEY_PASTE, BESTLINE_CMD_PASTE},
+    {0, BESTLINE_MOD_ALT, '<', BESTLINE_CMD_HISTORY_FIRST},
+    {0, BESTLINE_MOD_ALT, '>', BESTLINE_CMD_HISTORY_LAST},
+    {0, BESTLINE_MOD_ALT, 'B', BESTLINE_CMD_BARF},
+    {0, BESTLINE_MOD_ALT, 'S', BESTLINE_CMD_SLURP},
+    {0, BESTLINE_MOD_ALT, 'R', BESTLINE_CMD_RAISE},
+    {0, BESTLINE_MOD_ALT, 'y', BESTLINE_CMD_ROTATE},
+    {0, BESTLINE_MOD_ALT, '\\', BESTLINE_CMD_SQUEEZE},
+    {0, BESTLINE_MOD_ALT, 'b', BESTLINE_CMD_LEFT_WORD},
+    {0, BESTLINE_MOD_ALT, 'f', BESTLINE_CMD_RIGHT_WORD},
+    {0, BESTLINE_MOD_ALT, 'h', BESTLINE_CMD_RUBOUT_WORD},
+    {0, BESTLINE_MOD_ALT, 'd', BESTLINE_CMD_DELETE_WORD},
+    {0, BESTLINE_MOD_ALT, 'l', BESTLINE_CMD_LOWERCASE_WORD},
+    {0, BESTLINE_MOD_ALT, 'u', BESTLINE_CMD_UPPERCASE_WORD},
+    {0, BESTLINE_MOD_ALT, 'c', BESTLINE_CMD_CAPITALIZE_WORD},
+    {0, BESTLINE_MOD_ALT, 't', BESTLINE_CMD_TRANSPOSE_WORDS},
+    {0, BESTLINE_MOD_ALT, Ctrl('B'), BESTLINE_CMD_LEFT_EXPR},
+    {0, BESTLINE_MOD_ALT, Ctrl('F'), BESTLINE_CMD_RIGHT_EXPR},
+    {0, BESTLINE_MOD_ALT, Ctrl('H'), BESTLINE_CMD_RUBOUT_WORD},
+    {0, BESTLINE_MOD_ALT, BESTLINE_KEY_RIGHT, BESTLINE_CMD_RIGHT_EXPR},
+    {0, BESTLINE_MOD_ALT, BESTLINE_KEY_LEFT, BESTLINE_CMD_LEFT_EXPR},
+    {kKeymapCtrlX, 0, Ctrl('X'), BESTLINE_CMD_GOTO_MARK},
+    {kKeymapCtrlC, 0, Ctrl('C'), BESTLINE_CMD_INTERRUPT},
+    {kKeymapCtrlC, 0, Ctrl('B'), BESTLINE_CMD_BARF},
+    {kKeymapCtrlC, 0, Ctrl('S'), BESTLINE_CMD_SLURP},
+    {kKeymapCtrlC, 0, Ctrl('R'), BESTLINE_CMD_RAISE},
+};
+
+static unsigned bestlineKeySlot(unsigned key, unsigned mods) {
+    unsigned i;
+    if (key < 128) {
+        i = key;
+    } else if (key >= (unsigned)BESTLINE_KEY_UP && key <= (unsigned)BESTLINE_KEY_UNKNOWN) {
+        i = 128 + key - BESTLINE_KEY_UP;
+    } else {
+        i = kKeyRune;
+    }
+    return i * 8 + (mods & 7);
+}
+
+static int bestlineKeymapNew(void) {
+    unsigned short(*p)[kKeymapSlots];
+    if (nkeymaps >= kKeymapPrefix) {
+        errno = ENOMEM;
+        return -1;
+    }
+    if (!(p = (unsigned short(*)[kKeymapSlots])realloc(keymaps,
+                                                        (nkeymaps + 1) * sizeof(*keymaps))))
+        return -1;
+    keymaps = p;
+    memset(keymaps[nkeymaps], 0, sizeof(*keymaps));
+    return nkeymaps++;
+}
+
+static void bestlineKeymapCtrlC(void) {
+    if (nkeymaps)
+        keymaps[0][bestlineKeySlot(Ctrl('C'), 0)] =
+            emacsmode ? kKeymapPrefix | kKeymapCtrlC : BESTLINE_CMD_INTERRUPT;
+}
+
+static int bestlineKeymapInit(void) {
+    unsigned i;
+    const struct bestlineBinding *b;
+    if (nkeymaps)
+        return 0;
+    for (i = 0; i <= kKeymapCtrlC; ++i) {
+        if (bestlineKeymapNew() == -1) {
+            free(keymaps);
+            keymaps = 0;
+            nkeymaps = 0;
+            return -1;
+        }
+    }
+    for (i = ' '; i < 127; ++i)
+        keymaps[0][bestlineKeySlot(i, 0)] = BESTLINE_CMD_INSERT;
+    keymaps[0][bestlineKeySlot(kKeyRune, 0)] = BESTLINE_CMD_INSERT;
+    for (i = 0; i < sizeof(kBindings) / sizeof(*kBindings); ++i) {
+        b = kBindings + i;
+        keymaps[b->map][bestlineKeySlot(b->key, b->mods)] = b->cmd;
+    }
+    bestlineKeymapCtrlC();
+    return 0;
+}
+
+/**
+ * Returns command bound to the key that was just read.
+ *
+ * If it's the start of a chord then the next lookup uses its keymap.
+ * Keys that don't complete the chord are looked up in the top level,
+ * so CTRL-X followed by a letter still inserts the letter.
+ */
+static unsigned bestlineKeymapLookup(struct bestlineState *l) {
+    unsigned c, i;
+    if (bestlineKeymapInit() == -1 || (unsigned)l->keymap >= nkeymaps) {
+        l->keymap = 0;
+        return BESTLINE_CMD_NONE;
+    }
+    i = bestlineKeySlot(l->key.key, l->key.mods);
+    if (!(c = keymaps[l->keymap][i]))
+        c = keymaps[0][i];
+    l->keymap = 0;
+    if (c & kKeymapPrefix) {
+        l->keymap = c & ~kKeymapPrefix;
+        return BESTLINE_CMD_NONE;
+    }
+    return c;
+}
+
+static void bestlineEditCommand(struct bestlineState *l, bestlineCommandCallback *f) {
+    int pos;
+    char *p;
+    size_t i, n;
+    pos = l->pos;
+    if ((p = f(l->buf, &pos, &l->key))) {
+        n = strlen(p);
+        if (bestlineGrow(l, n + 1)) {
+            for (i = 0; i < n && i < l->len && p[i] == l->buf[i]; ++i) {
             }
+            memcpy(l->buf, p, n + 1);
+            l->len = n;
+            bestlineLayoutInvalidate(l, i);
         }
+        free(p);
     }
-    /* now move the text */
-    memcpy(rp, l->buf + point, start - point);
-    memmove(l->buf + point, l->buf + start, pos - start);
-    memcpy(l->buf + pos - (start - point), rp, start - point);
+    l->pos = pos < 0 ? 0 : Min((unsigned)pos, l->len);
     bestlineRefreshLine(l);
-    free(stack);
-}
-
-static void bestlineEditRaise(struct bestlineState *l) {
-    (void)l;
 }
 
-static char IsBalanced(struct abuf *buf) {
-    unsigned i, d;
-    for (d = i = 0; i < buf->len; ++i) {
-        if (buf->b[i] == '(')
-            ++d;
-        else if (d > 0 && buf->b[i] == ')')
-            --d;
+static void bestlineEditDispatch(struct bestlineState *l, unsigned c) {
+    if (c < kBuiltinCommands) {
+        kCommands[c](l);
+    } else if (c - kBuiltinCommands < ncommands) {
+        bestlineEditCommand(l, commands[c - kBuiltinCommands]);
     }
-    return d == 0;
+    l->lastcmd = c;
 }
 
 /**
@@ -3364,12 +6339,9 @@ static ssize_t bestlineEdit(int stdin_fd, int stdout_fd, const char *prompt, con
     ssize_t rc;
     char seq[16];
     const char *promptnotnull, *promptlastnl;
-    size_t nread;
-    int pastemode;
-    struct rune rune;
-    unsigned long long w;
     struct bestlineState l;
-    pastemode = 0;
+    if (bestlineKeymapInit() == -1)
+        return -1;
     memset(&l, 0, sizeof(l));
     if (!(l.buf = (char *)malloc((l.buflen = 32))))
         return -1;
@@ -3378,271 +6350,47 @@ static ssize_t bestlineEdit(int stdin_fd, int stdout_fd, const char *prompt, con
     l.ofd = stdout_fd;
     promptnotnull = prompt ? prompt : "";
     promptlastnl = strrchr(promptnotnull, '\n');
-    l.prompt = promptlastnl ? promptlastnl + 1 : promptnotnull;
+    bestlineSetPrompt(&l, promptlastnl ? promptlastnl + 1 : promptnotnull);
     l.ws = GetTerminalSize(l.ws, l.ifd, l.ofd);
     abInit(&l.full);
     bestlineHistoryAdd("");
     bestlineWriteStr(l.ofd, promptnotnull);
     init = init ? init : "";
     bestlineEditInsert(&l, init, strlen(init));
-    while (1) {
-        if (l.dirty)
-            bestlineRefreshLineForce(&l);
+    while (!l.done) {
         rc = bestlineRead(l.ifd, seq, sizeof(seq), &l);
         if (rc > 0) {
-            if (seq[0] == Ctrl('R')) {
-                rc = bestlineSearch(&l, seq, sizeof(seq));
-                if (!rc)
-                    continue;
-            } else if (seq[0] == '\t' && completionCallback) {
-                rc = bestlineCompleteLine(&l, seq, sizeof(seq));
-                if (!rc)
-                    continue;
-            }
-        }
-        if (rc > 0) {
-            nread = rc;
+            do {
+                l.again = 0;
+                bestlineEditDispatch(&l, bestlineKeymapLookup(&l));
+            } while (l.again && !l.done);
         } else if (!rc && l.len) {
-            nread = 1;
-            seq[0] = '\r';
-            seq[1] = 0;
+            bestlineEditDispatch(&l, BESTLINE_CMD_ACCEPT); /* eof submits what's been typed */
         } else {
-            if (historylen) {
-                free(history[--historylen]);
-                history[historylen] = 0;
-            }
-            free(l.buf);
-            abFree(&l.full);
-            return -1;
+            l.done = -1;
         }
-        switch (seq[0]) {
-            Case(Ctrl('P'), bestlineEditUp(&l));
-            Case(Ctrl('E'), bestlineEditEnd(&l));
-            Case(Ctrl('N'), bestlineEditDown(&l));
-            Case(Ctrl('A'), bestlineEditHome(&l));
-            Case(Ctrl('B'), bestlineEditLeft(&l));
-            Case(Ctrl('@'), bestlineEditMark(&l));
-            Case(Ctrl('Y'), bestlineEditYank(&l));
-            Case(Ctrl('Q'), bestlineEditCtrlq(&l));
-            Case(Ctrl('F'), bestlineEditRight(&l));
-            Case(Ctrl('\\'), bestlineEditQuit());
-            Case(Ctrl('S'), bestlineEditPause(&l));
-            Case(Ctrl('?'), bestlineEditRubout(&l));
-            Case(Ctrl('H'), bestlineEditRubout(&l));
-            Case(Ctrl('L'), bestlineEditRefresh(&l));
-            Case(Ctrl('Z'), bestlineEditSuspend());
-            Case(Ctrl('U'), bestlineEditKillLeft(&l));
-            Case(Ctrl('T'), bestlineEditTranspose(&l));
-            Case(Ctrl('K'), bestlineEditKillRight(&l));
-            Case(Ctrl('W'), bestlineEditRuboutWord(&l));
-        case Ctrl('C'):
-            if (emacsmode) {
-                if (bestlineRead(l.ifd, seq, sizeof(seq), &l) != 1)
-                    break;
-                switch (seq[0]) {
-                    Case(Ctrl('C'), bestlineEditInterrupt());
-                    Case(Ctrl('B'), bestlineEditBarf(&l));
-                    Case(Ctrl('S'), bestlineEditSlurp(&l));
-                    Case(Ctrl('R'), bestlineEditRaise(&l));
-                default:
-                    break;
-                }
-            } else {
-                bestlineEditInterrupt();
-            }
-            break;
-        case Ctrl('X'):
-            if (l.seq[1][0] == Ctrl('X')) {
-                bestlineEditGoto(&l);
-            }
-            break;
-        case Ctrl('D'):
-            if (l.len) {
-                bestlineEditDelete(&l);
-            } else {
-                if (historylen) {
-                    free(history[--historylen]);
-                    history[historylen] = 0;
-                }
-                free(l.buf);
-                abFree(&l.full);
-                return -1;
-            }
-            break;
-        case '\n':
-            l.final = 1;
-            bestlineEditEnd(&l);
-            bestlineRefreshLineForce(&l);
-            l.final = 0;
-            abAppend(&l.full, l.buf, l.len);
-            l.prompt = "... ";
-            abAppends(&l.full, "\n");
-            l.len = 0;
-            l.pos = 0;
-            bestlineWriteStr(stdout_fd, "\r\n");
-            bestlineRefreshLineForce(&l);
-            break;
-        case '\r': {
-            char is_finished = 1;
-            char needs_strip = 0;
-            if (historylen) {
-                free(history[--historylen]);
-                history[historylen] = 0;
-            }
-            l.final = 1;
-            bestlineEditEnd(&l);
-            bestlineRefreshLineForce(&l);
-            l.final = 0;
-            abAppend(&l.full, l.buf, l.len);
-            if (pastemode)
-                is_finished = 0;
-            if (balancemode)
-                if (!IsBalanced(&l.full))
-                    is_finished = 0;
-            if (llamamode)
-                if (StartsWith(l.full.b, "\"\"\""))
-                    needs_strip = is_finished = l.full.len > 6 && EndsWith(l.full.b, "\"\"\"");
-            if (is_finished) {
-                if (needs_strip) {
-                    int len = l.full.len - 6;
-                    *obuf = strndup(l.full.b + 3, len);
-                    abFree(&l.full);
-                    free(l.buf);
-                    return len;
-                } else {
-                    *obuf = l.full.b;
-                    free(l.buf);
-                    return l.full.len;
-                }
-            } else {
-                l.prompt = "... ";
-                abAppends(&l.full, "\n");
-                l.len = 0;
-                l.pos = 0;
-                bestlineWriteStr(stdout_fd, "\r\n");
-                bestlineRefreshLineForce(&l);
-            }
-            break;
+    }
+    if (l.done > 0) {
+        if (llamamode && StartsWith(l.full.b, "\"\"\"")) {
+            rc = l.full.len - 6;
+            *obuf = strndup(l.full.b + 3, rc);
+            abFree(&l.full);
+        } else {
+            *obuf = l.full.b;
+            rc = l.full.len;
         }
-        case 033:
-            if (nread < 2)
-                break;
-            switch (seq[1]) {
-                Case('<', bestlineEditBof(&l));
-                Case('>', bestlineEditEof(&l));
-                Case('B', bestlineEditBarf(&l));
-                Case('S', bestlineEditSlurp(&l));
-                Case('R', bestlineEditRaise(&l));
-                Case('y', bestlineEditRotate(&l));
-                Case('\\', bestlineEditSqueeze(&l));
-                Case('b', bestlineEditLeftWord(&l));
-                Case('f', bestlineEditRightWord(&l));
-                Case('h', bestlineEditRuboutWord(&l));
-                Case('d', bestlineEditDeleteWord(&l));
-                Case('l', bestlineEditLowercaseWord(&l));
-                Case('u', bestlineEditUppercaseWord(&l));
-                Case('c', bestlineEditCapitalizeWord(&l));
-                Case('t', bestlineEditTransposeWords(&l));
-                Case(Ctrl('B'), bestlineEditLeftExpr(&l));
-                Case(Ctrl('F'), bestlineEditRightExpr(&l));
-                Case(Ctrl('H'), bestlineEditRuboutWord(&l));
-            case '[':
-                if (nread == 6 && !memcmp(seq, "\033[200~", 6)) {
-                    pastemode = 1;
-                    break;
-                }
-                if (nread == 6 && !memcmp(seq, "\033[201~", 6)) {
-                    pastemode = 0;
-                    break;
-                }
-                if (nread < 3)
-                    break;
-                if (seq[2] >= '0' && seq[2] <= '9') {
-                    if (nread < 4)
-                        break;
-                    if (seq[3] == '~') {
-                        switch (seq[2]) {
-                            Case('1', bestlineEditHome(&l)); /* \e[1~ */
-                            Case('3', bestlineEditDelete(&l)); /* \e[3~ */
-                            Case('4', bestlineEditEnd(&l)); /* \e[4~ */
-                        default:
-                            break;
-                        }
-                    }
-                } else {
-                    switch (seq[2]) {
-                        Case('A', bestlineEditUp(&l));
-                        Case('B', bestlineEditDown(&l));
-                        Case('C', bestlineEditRight(&l));
-                        Case('D', bestlineEditLeft(&l));
-                        Case('H', bestlineEditHome(&l));
-                        Case('F', bestlineEditEnd(&l));
-                    default:
-                        break;
-                    }
-                }
-                break;
-            case 'O':
-                if (nread < 3)
-                    break;
-                switch (seq[2]) {
-                    Case('A', bestlineEditUp(&l));
-                    Case('B', bestlineEditDown(&l));
-                    Case('C', bestlineEditRight(&l));
-                    Case('D', bestlineEditLeft(&l));
-                    Case('H', bestlineEditHome(&l));
-                    Case('F', bestlineEditEnd(&l));
-                default:
-                    break;
-                }
-                break;
-            case 033:
-                if (nread < 3)
-                    break;
-                switch (seq[2]) {
-                case '[':
-                    if (nread < 4)
-                        break;
-                    switch (seq[3]) {
-                        Case('C', bestlineEditRightExpr(&l)); /* \e\e[C alt-right */
-                        Case('D', bestlineEditLeftExpr(&l)); /* \e\e[D alt-left */
-                    default:
-                        break;
-                    }
-                    break;
-                case 'O':
-                    if (nread < 4)
-                        break;
-                    switch (seq[3]) {
-                        Case('C', bestlineEditRightExpr(&l)); /* \e\eOC alt-right */
-                        Case('D', bestlineEditLeftExpr(&l)); /* \e\eOD alt-left */
-                    default:
-                        break;
-                    }
-                    break;
-                default:
-                    break;
-                }
-                break;
-            default:
-                break;
-            }
-            break;
-        default:
-            if (!IsControl(seq[0])) { /* only sees canonical c0 */
-                if (xlatCallback) {
-                    rune = GetUtf8(seq, nread);
-                    w = EncodeUtf8(xlatCallback(rune.c));
-                    nread = 0;
-                    do {
-                        seq[nread++] = w;
-                    } while ((w >>= 8));
-                }
-                bestlineEditInsert(&l, seq, nread);
-            }
-            break;
+    } else {
+        if (historylen) {
+            free(history[--historylen]);
+            history[historylen] = 0;
         }
+        abFree(&l.full);
+        rc = -1;
     }
+    bestlineLayoutFree(&l);
+    bestlineRenderFree(&l);
+    free(l.buf);
+    return rc;
 }
 
 void bestlineFree(void *ptr) {
@@ -3661,18 +6409,36 @@ void bestlineHistoryFree(void) {
 }
 
 static void bestlineAtExit(void) {
+    unsigned i;
     bestlineDisableRawMode();
+    for (i = 0; i < sizeof(inbufs) / sizeof(*inbufs); ++i) {
+        free(inbufs[i].b);
+        inbufs[i].b = 0;
+        inbufs[i].cap = inbufs[i].i = inbufs[i].n = 0;
+    }
     bestlineHistoryFree();
     bestlineRingFree();
+    bestlineHintsFree();
+    while (nstyles)
+        free(styles[--nstyles]);
+    free(styles);
+    styles = 0;
+    stylecap = 0;
+    bestlineResetKeymap();
+    free(commands);
+    commands = 0;
+    ncommands = 0;
 }
 
 int bestlineHistoryAdd(const char *line) {
+    size_t n;
     char *linecopy;
     if (!BESTLINE_MAX_HISTORY)
         return 0;
     if (historylen && !strcmp(history[historylen - 1], line))
         return 0;
-    if (!(linecopy = strdup(line)))
+    n = strlen(line);
+    if (!(linecopy = CopyUtf8(line, &n)))
         return 0;
     if (historylen == BESTLINE_MAX_HISTORY) {
         free(history[0]);
@@ -3744,8 +6510,8 @@ int bestlineHistoryLoad(const char *filename) {
                 bestlineHistoryFree();
                 for (j = 0; j < BESTLINE_MAX_HISTORY; ++j) {
                     if (h[(k = (i + j) % BESTLINE_MAX_HISTORY) * 2]) {
-                        if ((s = (char *)malloc((t = h[k * 2 + 1] - h[k * 2]) + 1))) {
-                            memcpy(s, h[k * 2], t), s[t] = 0;
+                        t = h[k * 2 + 1] - h[k * 2];
+                        if ((s = CopyUtf8(h[k * 2], &t))) {
                             history[historylen++] = s;
                         }
                     }
@@ -3786,6 +6552,10 @@ char *bestlineRawInit(const char *prompt, const char *init, int infd, int outfd)
     sigaction(SIGINT, sa, sa + 1);
     sigaction(SIGQUIT, sa, sa + 2);
     bestlineWriteStr(outfd, "\033[?2004h"); // enable bracketed paste mode
+    if (!syncquery) {
+        bestlineWriteStr(outfd, "\033[?2026$p"); // ask about synchronized output
+        syncquery = 1;
+    }
     rc = bestlineEdit(infd, outfd, prompt, init, &buf);
     bestlineWriteStr(outfd, "\033[?2004l"); // disable bracketed paste mode
     bestlineDisableRawMode();
@@ -3941,6 +6711,108 @@ void bestlineSetCompletionCallback(bestlineCompletionCallback *fn) {
  */
 void bestlineSetHintsCallback(bestlineHintsCallback *fn) {
     hintsCallback = fn;
+    bestlineInvalidateHints();
+}
+
+/**
+ * Registers asynchronous hints callback.
+ *
+ * This is for hints that take a while to come up with, e.g. because
+ * they're looked up in a database. Whenever the line changes, 𝑓𝑛 is
+ * called with the line and a new generation number. It should return
+ * right away, e.g. after handing the work to another thread, which
+ * later answers by calling bestlinePostHint() with that generation.
+ * Meanwhile the line is drawn without a hint. Answers for a line that
+ * has since changed are dropped.
+ *
+ * This takes precedence over bestlineSetHintsCallback().
+ *
+ * @param fn is called with a string only valid during the call, or
+ *     null to go back to synchronous hints
+ * @return 0 on success, or -1 w/ errno if the wakeup pipe failed
+ */
+int bestlineSetAsyncHintsCallback(bestlineAsyncHintsCallback *fn) {
+    int i;
+    if (fn && !hintsopen) {
+        if (pipe(hintsfd) == -1)
+            return -1;
+        for (i = 0; i < 2; ++i) {
+            fcntl(hintsfd[i], F_SETFL, fcntl(hintsfd[i], F_GETFL) | O_NONBLOCK);
+            fcntl(hintsfd[i], F_SETFD, FD_CLOEXEC);
+        }
+        hintsopen = 1;
+    }
+    asyncHintsCallback = fn;
+    return 0;
+}
+
+/**
+ * Answers an asynchronous hints request.
+ *
+ * This may be called from any thread. The line is redrawn with the
+ * hint if it hasn't changed since 𝑔𝑒𝑛 was requested. The strings are
+ * copied, so the caller still owns them.
+ *
+ * @param gen is the generation passed to the async hints callback
+ * @param hint is text to show right of the cursor, or null for none
+ * @param ansi1 is the code before the hint, or null for gray
+ * @param ansi2 is the code after the hint, or null for default color
+ * @return 0 on success, or -1 w/ errno, e.g. EMSGSIZE if the hint is
+ *     too long to send atomically, or EAGAIN if the pipe is full
+ */
+int bestlinePostHint(unsigned long gen, const char *hint, const char *ansi1, const char *ansi2) {
+    size_t n;
+    char msg[PIPE_BUF];
+    struct bestlineHintHeader h;
+    if (!hintsopen) {
+        errno = EBADF;
+        return -1;
+    }
+    if (!hint)
+        hint = "";
+    if (!ansi1)
+        ansi1 = "\033[90m";
+    if (!ansi2)
+        ansi2 = "\033[39m";
+    h.gen = gen;
+    h.n[0] = n = strlen(hint);
+    h.n[1] = strlen(ansi1);
+    h.n[2] = strlen(ansi2);
+    if (sizeof(h) + n + h.n[1] + h.n[2] > sizeof(msg)) {
+        errno = EMSGSIZE;
+        return -1;
+    }
+    memcpy(msg, &h, sizeof(h));
+    memcpy(msg + sizeof(h), hint, n);
+    memcpy(msg + sizeof(h) + n, ansi1, h.n[1]);
+    memcpy(msg + sizeof(h) + n + h.n[1], ansi2, h.n[2]);
+    n = sizeof(h) + n + h.n[1] + h.n[2];
+    return write(hintsfd[1], msg, n) == (ssize_t)n ? 0 : -1;
+}
+
+/**
+ * Enables or disables caching of hints.
+ *
+ * By default the hints callback is only asked about a line once, and
+ * what it said is remembered for the few most recent lines, so moving
+ * the cursor or resizing doesn't ask it again. Hints that depend on
+ * state outside the line, e.g. a clock, should turn this off, or call
+ * bestlineInvalidateHints() whenever that state changes.
+ *
+ * @param mode is 1 to enable, or 0 to disable
+ */
+void bestlineHintsCacheMode(char mode) {
+    hintsnocache = !mode;
+    bestlineInvalidateHints();
+}
+
+/**
+ * Forgets cached hints, so the hints callback is asked again.
+ */
+void bestlineInvalidateHints(void) {
+    size_t i;
+    for (i = 0; i < BESTLINE_MAX_HINTS; ++i)
+        hints[i].used = 0;
 }
 
 /**
@@ -3960,6 +6832,95 @@ void bestlineSetXlatCallback(bestlineXlatCallback *fn) {
     xlatCallback = fn;
 }
 
+/**
+ * Registers syntax highlighting callback.
+ *
+ * The callback is called as 𝑓𝑛(line, len, pos, state, h) and should
+ * lex line[pos,len) starting in lexer 𝑠𝑡𝑎𝑡𝑒, calling
+ * bestlineAddHighlight() for each span that should be styled and
+ * bestlineAddCheckpoint() at places where it could resume later, such
+ * as the start of each token. The first call for a line has 𝑝𝑜𝑠 and
+ * 𝑠𝑡𝑎𝑡𝑒 of zero. After an edit, the callback is resumed from the last
+ * checkpoint before the first byte that changed, and what it said
+ * about the line before that checkpoint is kept.
+ *
+ * @param fn is callback, or null to turn highlighting off
+ */
+void bestlineSetHighlightCallback(bestlineHighlightCallback *fn) {
+    highlightCallback = fn;
+}
+
+/**
+ * Adds span of highlighting.
+ *
+ * This is used by the highlight callback to style line[start,end) with
+ * the ansi select graphic rendition parameters 𝑠𝑔𝑟, e.g. "1;34" for
+ * bold blue. Spans need to be added in order and must not overlap.
+ * Styles are interned, so 𝑠𝑔𝑟 doesn't need to outlive the call.
+ */
+void bestlineAddHighlight(bestlineHighlights *h, unsigned long start, unsigned long end,
+                          const char *sgr) {
+    unsigned i;
+    char *s, **p;
+    struct bestlineSpan *q;
+    start = Max(start, h->resume);
+    if (h->n)
+        start = Max(start, h->span[h->n - 1].end);
+    end = Min(end, h->len);
+    if (start >= end || !sgr || !*sgr)
+        return;
+    for (i = 0; i < nstyles; ++i)
+        if (!strcmp(styles[i], sgr))
+            break;
+    if (i == nstyles) {
+        if (nstyles == stylecap) {
+            if (!(p = (char **)realloc(styles, (stylecap * 2 + 8) * sizeof(*p))))
+                return;
+            styles = p;
+            stylecap = stylecap * 2 + 8;
+        }
+        if (!(s = strdup(sgr)))
+            return;
+        styles[nstyles++] = s;
+    }
+    if (h->n && h->span[h->n - 1].end == start && h->span[h->n - 1].style == i + 1) {
+        h->span[h->n - 1].end = end;
+        return;
+    }
+    if (h->n == h->cap) {
+        if (!(q = (struct bestlineSpan *)realloc(h->span, (h->cap * 2 + 16) * sizeof(*q))))
+            return;
+        h->span = q;
+        h->cap = h->cap * 2 + 16;
+    }
+    h->span[h->n].start = start;
+    h->span[h->n].end = end;
+    h->span[h->n].style = i + 1;
+    ++h->n;
+}
+
+/**
+ * Records lexer state at position in line.
+ *
+ * This is used by the highlight callback, so after 𝑝𝑜𝑠 is edited, it
+ * can be asked to resume from here with 𝑠𝑡𝑎𝑡𝑒, rather than start over.
+ * The state at 𝑝𝑜𝑠 must only depend on line[0,pos).
+ */
+void bestlineAddCheckpoint(bestlineHighlights *h, unsigned long pos, unsigned long state) {
+    struct bestlineCheckpoint *q;
+    if (pos <= h->resume || pos > h->len || (h->nck && pos <= h->ck[h->nck - 1].pos))
+        return;
+    if (h->nck == h->ckcap) {
+        if (!(q = (struct bestlineCheckpoint *)realloc(h->ck, (h->ckcap * 2 + 16) * sizeof(*q))))
+            return;
+        h->ck = q;
+        h->ckcap = h->ckcap * 2 + 16;
+    }
+    h->ck[h->nck].pos = pos;
+    h->ck[h->nck].state = state;
+    ++h->nck;
+}
+
 /**
  * Adds completion.
  *
@@ -3971,8 +6932,8 @@ void bestlineSetXlatCallback(bestlineXlatCallback *fn) {
 void bestlineAddCompletion(bestlineCompletions *lc, const char *str) {
     size_t len;
     char *copy, **cvec;
-    if ((copy = (char *)malloc((len = strlen(str)) + 1))) {
-        memcpy(copy, str, len + 1);
+    len = strlen(str);
+    if ((copy = CopyUtf8(str, &len))) {
         if ((cvec = (char **)realloc(lc->cvec, (lc->len + 1) * sizeof(*lc->cvec)))) {
             lc->cvec = cvec;
             lc->cvec[lc->len++] = copy;
@@ -4059,9 +7020,160 @@ void bestlineLlamaMode(char mode) {
  *
  * This mode remaps CTRL-C so you can use additional shortcuts, like C-c
  * C-s for slurp. By default, CTRL-C raises SIGINT for exiting programs.
+ * Calling this replaces any custom binding of CTRL-C.
  */
 void bestlineEmacsMode(char mode) {
     emacsmode = mode;
+    bestlineKeymapCtrlC();
+}
+
+/**
+ * Registers command that key bindings may run.
+ *
+ * The callback is passed the line, a pointer to the cursor's byte offset
+ * which it may change, and the key that was pressed. It may return a
+ * malloc()'d string that replaces the line, or NULL to leave it alone.
+ *
+ * @return command for bestlineBindKey(), or -1 w/ errno
+ */
+int bestlineAddCommand(bestlineCommandCallback *fn) {
+    bestlineCommandCallback **p;
+    if (kBuiltinCommands + ncommands >= kKeymapPrefix) {
+        errno = ENOMEM;
+        return -1;
+    }
+    if (!(p = (bestlineCommandCallback **)realloc(commands, (ncommands + 1) * sizeof(*commands))))
+        return -1;
+    commands = p;
+    commands[ncommands] = fn;
+    return kBuiltinCommands + ncommands++;
+}
+
+/**
+ * Binds key to command.
+ *
+ * Code points above ASCII share a single binding, which by default is
+ * BESTLINE_CMD_INSERT when no modifiers are held.
+ *
+ * @param map is 0 for the top-level keymap, or what bestlineBindPrefix()
+ *     returned to bind the key that completes a chord
+ * @param key is a unicode code point or BESTLINE_KEY_...
+ * @param mods is a mask of BESTLINE_MOD_...
+ * @param cmd is BESTLINE_CMD_... or what bestlineAddCommand() returned
+ * @return 0 on success, or -1 w/ errno
+ */
+int bestlineBindKey(int map, unsigned key, unsigned mods, int cmd) {
+    if (bestlineKeymapInit() == -1)
+        return -1;
+    if (map < 0 || (unsigned)map >= nkeymaps || cmd < 0 ||
+        (unsigned)cmd >= kBuiltinCommands + ncommands) {
+        errno = EINVAL;
+        return -1;
+    }
+    keymaps[map][bestlineKeySlot(key, mods)] = cmd;
+    return 0;
+}
+
+/**
+ * Makes key the first keystroke of a chord, e.g. CTRL-X.
+ *
+ * If the key is already a prefix then its existing keymap is returned,
+ * otherwise it's bound to a new keymap where every key does nothing.
+ *
+ * @return keymap for bestlineBindKey(), or -1 w/ errno
+ */
+int bestlineBindPrefix(int map, unsigned key, unsigned mods) {
+    int m;
+    unsigned i;
+    if (bestlineKeymapInit() == -1)
+        return -1;
+    if (map < 0 || (unsigned)map >= nkeymaps) {
+        errno = EINVAL;
+        return -1;
+    }
+    i = bestlineKeySlot(key, mods);
+    if (keymaps[map][i] & kKeymapPrefix)
+        return keymaps[map][i] & ~kKeymapPrefix;
+    if ((m = bestlineKeymapNew()) == -1)
+        return -1;
+    keymaps[map][i] = kKeymapPrefix | m;
+    return m;
+}
+
+/**
+ * Restores default key bindings.
+ *
+ * Commands added by bestlineAddCommand() remain registered.
+ */
+void bestlineResetKeymap(void) {
+    free(keymaps);
+    keymaps = 0;
+    nkeymaps = 0;
+}
+
+/**
+ * Enables or disables "smart case" for CTRL-R history search.
+ *
+ * When it's enabled, a search string that's all lowercase will match
+ * text regardless of case, e.g. "σ" finds "Σ" and "ς" too. As soon as
+ * the search string has an uppercase character, matching goes back to
+ * being case sensitive. It's disabled by default.
+ *
+ * @param mode is 1 to enable, or 0 to disable
+ */
+void bestlineSmartCaseMode(char mode) {
+    smartcase = mode;
+}
+
+/**
+ * Sets minimum amount of time between screen updates.
+ *
+ * Keystrokes that arrive faster than this, e.g. from key repeat or a
+ * slow paste, are applied to the line without redrawing it, and then
+ * the latest state gets drawn once the interval has elapsed. Slow
+ * terminals may benefit from a longer interval. The default is 1/60th
+ * of a second.
+ *
+ * @param usec is microseconds, or 0 to redraw whenever input is idle
+ */
+void bestlineSetFrameInterval(unsigned long usec) {
+    frameinterval = usec + (usec != -1ul);
+}
+
+/**
+ * Sets how long a refresh may take while keystrokes are backing up.
+ *
+ * If the last complete refresh took longer than this, and there's more
+ * input waiting, then hints and bracket highlighting are skipped until
+ * input goes idle. This keeps slow hints callbacks from making typing
+ * lag. The default is 5000 microseconds.
+ *
+ * @param usec is microseconds, or 0 to never skip anything
+ * @see bestlineGetDegradedFrames()
+ */
+void bestlineSetRenderBudget(unsigned long usec) {
+    renderbudget = usec + (usec != -1ul);
+}
+
+/**
+ * Returns how many times a refresh skipped work to keep up with input.
+ */
+unsigned long bestlineGetDegradedFrames(void) {
+    return degradedframes;
+}
+
+/**
+ * Controls low bandwidth mode.
+ *
+ * This mode is intended for serial consoles and congested links. It
+ * picks whichever cursor movement takes the fewest bytes, and doesn't
+ * show hints or highlight matching brackets. The default is to turn it
+ * on automatically when the terminal's output speed is under 38400 baud.
+ *
+ * @param mode is 1 to enable, 0 to disable, or -1 for automatic
+ */
+void bestlineSetLowBandwidth(int mode) {
+    lowbandwidth = mode < 0 ? 0 : 1 + !!mode;
 }
 
 /**
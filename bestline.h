@@ -8,18 +8,127 @@ typedef struct bestlineCompletions {
     char **cvec;
 } bestlineCompletions;
 
+enum bestlineMods {
+    BESTLINE_MOD_SHIFT = 1,
+    BESTLINE_MOD_ALT = 2,
+    BESTLINE_MOD_CTRL = 4
+};
+
+enum bestlineKeys {
+    BESTLINE_KEY_UP = 0x110000, /* keys that aren't unicode start here */
+    BESTLINE_KEY_DOWN,
+    BESTLINE_KEY_RIGHT,
+    BESTLINE_KEY_LEFT,
+    BESTLINE_KEY_HOME,
+    BESTLINE_KEY_END,
+    BESTLINE_KEY_INSERT,
+    BESTLINE_KEY_DELETE,
+    BESTLINE_KEY_PAGEUP,
+    BESTLINE_KEY_PAGEDOWN,
+    BESTLINE_KEY_F1,
+    BESTLINE_KEY_F2,
+    BESTLINE_KEY_F3,
+    BESTLINE_KEY_F4,
+    BESTLINE_KEY_F5,
+    BESTLINE_KEY_F6,
+    BESTLINE_KEY_F7,
+    BESTLINE_KEY_F8,
+    BESTLINE_KEY_F9,
+    BESTLINE_KEY_F10,
+    BESTLINE_KEY_F11,
+    BESTLINE_KEY_F12,
+    BESTLINE_KEY_PASTE, /* start of bracketed paste */
+    BESTLINE_KEY_PASTE_END,
+    BESTLINE_KEY_UNKNOWN /* escape sequence we don't know */
+};
+
+typedef struct bestlineKey {
+    unsigned key; /* unicode code point or BESTLINE_KEY_... */
+    unsigned mods; /* BESTLINE_MOD_... */
+    char text[8]; /* utf-8 of key if it's a code point */
+} bestlineKey;
+
+enum bestlineCommands {
+    BESTLINE_CMD_NONE, /* ignores key */
+    BESTLINE_CMD_INSERT, /* inserts key text */
+    BESTLINE_CMD_ACCEPT, /* enter */
+    BESTLINE_CMD_NEWLINE, /* continues on next line */
+    BESTLINE_CMD_DELETE_OR_EOF,
+    BESTLINE_CMD_PASTE, /* reads bracketed paste */
+    BESTLINE_CMD_SEARCH, /* reverse history search */
+    BESTLINE_CMD_COMPLETE, /* tab completion */
+    BESTLINE_CMD_UP,
+    BESTLINE_CMD_DOWN,
+    BESTLINE_CMD_LEFT,
+    BESTLINE_CMD_RIGHT,
+    BESTLINE_CMD_HOME,
+    BESTLINE_CMD_END,
+    BESTLINE_CMD_HISTORY_FIRST,
+    BESTLINE_CMD_HISTORY_LAST,
+    BESTLINE_CMD_LEFT_WORD,
+    BESTLINE_CMD_RIGHT_WORD,
+    BESTLINE_CMD_LEFT_EXPR,
+    BESTLINE_CMD_RIGHT_EXPR,
+    BESTLINE_CMD_DELETE,
+    BESTLINE_CMD_RUBOUT,
+    BESTLINE_CMD_DELETE_WORD,
+    BESTLINE_CMD_RUBOUT_WORD,
+    BESTLINE_CMD_LOWERCASE_WORD,
+    BESTLINE_CMD_UPPERCASE_WORD,
+    BESTLINE_CMD_CAPITALIZE_WORD,
+    BESTLINE_CMD_KILL_LEFT,
+    BESTLINE_CMD_KILL_RIGHT,
+    BESTLINE_CMD_YANK,
+    BESTLINE_CMD_ROTATE, /* replaces what was just yanked */
+    BESTLINE_CMD_TRANSPOSE,
+    BESTLINE_CMD_TRANSPOSE_WORDS,
+    BESTLINE_CMD_SQUEEZE,
+    BESTLINE_CMD_MARK,
+    BESTLINE_CMD_GOTO_MARK,
+    BESTLINE_CMD_BARF,
+    BESTLINE_CMD_SLURP,
+    BESTLINE_CMD_RAISE,
+    BESTLINE_CMD_REFRESH,
+    BESTLINE_CMD_PAUSE,
+    BESTLINE_CMD_QUOTE, /* resumes output or inserts next key escaped */
+    BESTLINE_CMD_INTERRUPT,
+    BESTLINE_CMD_QUIT,
+    BESTLINE_CMD_SUSPEND
+};
+
 typedef void(bestlineCompletionCallback)(const char *, int,
                                          bestlineCompletions *);
 typedef char *(bestlineHintsCallback)(const char *, const char **, const char **);
 typedef void(bestlineFreeHintsCallback)(void *);
+typedef void(bestlineAsyncHintsCallback)(const char *, unsigned long);
 typedef unsigned(bestlineXlatCallback)(unsigned);
+typedef struct bestlineHighlights bestlineHighlights;
+typedef void(bestlineHighlightCallback)(const char *, unsigned long, unsigned long,
+                                        unsigned long, bestlineHighlights *);
+typedef char *(bestlineCommandCallback)(const char *, int *, const bestlineKey *);
 
 void bestlineSetCompletionCallback(bestlineCompletionCallback *);
 void bestlineSetHintsCallback(bestlineHintsCallback *);
 void bestlineSetFreeHintsCallback(bestlineFreeHintsCallback *);
+int bestlineSetAsyncHintsCallback(bestlineAsyncHintsCallback *);
+int bestlinePostHint(unsigned long, const char *, const char *, const char *);
+void bestlineHintsCacheMode(char);
+void bestlineInvalidateHints(void);
 void bestlineAddCompletion(bestlineCompletions *, const char *);
 void bestlineSetXlatCallback(bestlineXlatCallback *);
+void bestlineSetHighlightCallback(bestlineHighlightCallback *);
+void bestlineAddHighlight(bestlineHighlights *, unsigned long, unsigned long, const char *);
+void bestlineAddCheckpoint(bestlineHighlights *, unsigned long, unsigned long);
+int bestlineAddCommand(bestlineCommandCallback *);
+int bestlineBindKey(int, unsigned, unsigned, int);
+int bestlineBindPrefix(int, unsigned, unsigned);
+void bestlineResetKeymap(void);
 
+/* Input that's already waiting when a keystroke is read, e.g. lines
+ * typed ahead or pasted, is taken in a single read and kept for later
+ * calls on the same fd, instead of being left in the kernel for other
+ * readers such as child processes. Build with BESTLINE_MAX_READAHEAD=1
+ * to read one byte at a time. */
 char *bestline(const char *);
 char *bestlineInit(const char *, const char *);
 char *bestlineRaw(const char *, int, int);
@@ -39,17 +148,24 @@ void bestlineHistoryFree(void);
 void bestlineLlamaMode(char);
 void bestlineMaskModeDisable(void);
 void bestlineMaskModeEnable(void);
+void bestlineSmartCaseMode(char);
+void bestlineSetFrameInterval(unsigned long);
+void bestlineSetLowBandwidth(int);
+void bestlineSetRenderBudget(unsigned long);
+unsigned long bestlineGetDegradedFrames(void);
 
 void bestlineUserIO(int (*)(int, void *, int), int (*)(int, const void *, int),
                     int (*)(int, int, int));
 
 int bestlineCharacterWidth(int);
+unsigned long bestlineStringWidth(const char *, unsigned long);
 char bestlineIsSeparator(unsigned);
 char bestlineNotSeparator(unsigned);
 char bestlineIsXeparator(unsigned);
 unsigned bestlineUppercase(unsigned);
 unsigned bestlineLowercase(unsigned);
 long bestlineReadCharacter(int, char *, unsigned long);
+long bestlineReadKey(int, bestlineKey *);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,500 @@
+/*-*- mode:c;indent-tabs-mode:nil;c-basic-offset:4;tab-width:8;coding:utf-8 -*-│
+│ vi: set et ft=c ts=4 sts=4 sw=4 fenc=utf-8                               :vi │
+╞══════════════════════════════════════════════════════════════════════════════╡
+│                                                                              │
+│ mkunicode ── Generates the UNICODE lookup tables embedded in bestline.c      │
+│                                                                              │
+│ USAGE                                                                        │
+│                                                                              │
+│   make unicode-tables                                                        │
+│                                                                              │
+│   This rewrites the region of bestline.c that sits between the BEGIN         │
+│   and END GENERATED UNICODE TABLES markers. The output is checked in         │
+│   so bestline.c stays a single file that can be dropped into any             │
+│   project without needing this tool.                                         │
+│                                                                              │
+│ DATA                                                                         │
+│                                                                              │
+│   UnicodeData.txt, EastAsianWidth.txt, BidiBrackets.txt, CaseFolding.txt,    │
+│   GraphemeBreakProperty.txt and emoji-data.txt in this directory hold        │
+│   version 14.0.0 of the Unicode Character Database, © Unicode, Inc.,         │
+│   which may be copied under the terms at                                     │
+│   https://www.unicode.org/license.txt.                                       │
+│   To upgrade, drop in the files of the same name from                        │
+│   https://www.unicode.org/Public/UCD/latest/ucd/ and its auxiliary and       │
+│   emoji subdirectories, then run make unicode-tables.                        │
+│                                                                              │
+│ TABLES                                                                       │
+│                                                                              │
+│   kWidth  three stage trie of 2-bit monospace widths where the top           │
+│           stage is indexed by c>>12, the middle stage by c>>6&63, and        │
+│           the leaves hold sixty-four codepoints packed four per byte         │
+│                                                                              │
+│   kWord   three stage trie of bits that are set for letters, numbers,        │
+│           marks and other symbols, indexed by c>>12, c>>7&31 and then        │
+│           c>>3&15 to pick a byte out of each 128 codepoint leaf              │
+│                                                                              │
+│   kDelta  three stage trie indexed by c>>9, c>>4&31 and c&15 whose           │
+│           leaves pick a row of five deltas, which are the simple             │
+│           lowercase, simple uppercase, opening bracket of a closing          │
+│           bracket, closing bracket of an opening bracket, and simple         │
+│           case folding. Deltas are mod 2¹⁶ since no mapping leaves           │
+│           its plane; 0 is none                                               │
+│                                                                              │
+│   kGrapheme  three stage trie of 4-bit Grapheme_Cluster_Break classes        │
+│              indexed by c>>12, c>>6&63 and c&63, where the class             │
+│              kGraphemePictographic stands for Other that's also              │
+│              Extended_Pictographic                                           │
+│                                                                              │
+╚─────────────────────────────────────────────────────────────────────────────*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define kMaxRune 0x110000
+#define kBegin "/* BEGIN GENERATED UNICODE TABLES (make unicode-tables) */\n"
+#define kEnd "/* END GENERATED UNICODE TABLES */\n"
+
+/*
+ * Grapheme_Cluster_Break values in the order of the kGrapheme enum,
+ * which is followed by kGraphemePictographic.
+ */
+static const char *const kGraphemeNames[] = {
+    "Other", "CR", "LF", "Control",     "Extend", "ZWJ", "Regional_Indicator",
+    "Prepend", "SpacingMark", "L", "V", "T", "LV", "LVT", "Pictographic",
+};
+
+struct buf {
+    char *p;
+    size_t n, c;
+};
+
+static unsigned char width[kMaxRune];
+static unsigned char word[kMaxRune];
+static unsigned char deltaidx[kMaxRune];
+static unsigned delta[kMaxRune][5];
+static unsigned char grapheme[kMaxRune];
+static unsigned rows[256][5];
+static size_t nrows;
+
+static void Append(struct buf *b, const char *s, size_t n) {
+    if (b->n + n + 1 > b->c) {
+        do
+            b->c = b->c ? b->c * 2 : 4096;
+        while (b->n + n + 1 > b->c);
+        if (!(b->p = (char *)realloc(b->p, b->c))) {
+            perror("realloc");
+            exit(1);
+        }
+    }
+    memcpy(b->p + b->n, s, n);
+    b->p[b->n += n] = 0;
+}
+
+static void Appends(struct buf *b, const char *s) {
+    Append(b, s, strlen(s));
+}
+
+static void Appendf(struct buf *b, const char *fmt, unsigned x) {
+    char t[64];
+    snprintf(t, sizeof(t), fmt, x);
+    Appends(b, t);
+}
+
+static void Appendv(struct buf *b, const char *fmt, const char *x) {
+    char t[64];
+    snprintf(t, sizeof(t), fmt, x);
+    Appends(b, t);
+}
+
+static void AppendBytes(struct buf *b, const unsigned char *p, size_t n, int nested) {
+    size_t i;
+    for (i = 0; i < n; ++i) {
+        if (!(i % 16))
+            Appends(b, !nested ? "\n    " : i ? "\n     " : "\n    {");
+        Appendf(b, "0x%02x", p[i]);
+        if (i + 1 < n || !nested)
+            Appends(b, (i + 1) % 16 ? ", " : ",");
+    }
+    if (nested)
+        Appends(b, "},");
+}
+
+/*
+ * Deduplicates fixed size chunks of an array, storing the index of
+ * each chunk in idx and returning the number of unique chunks, which
+ * are compacted to the front of the array.
+ */
+static size_t Dedupe(unsigned char *p, size_t n, size_t size, unsigned *idx) {
+    size_t i, j, m;
+    for (m = i = 0; i < n; ++i) {
+        for (j = 0; j < m; ++j) {
+            if (!memcmp(p + j * size, p + i * size, size))
+                break;
+        }
+        if (j == m) {
+            memmove(p + m * size, p + i * size, size);
+            ++m;
+        }
+        idx[i] = j;
+    }
+    return m;
+}
+
+static unsigned GetPacked(const unsigned char *leaf, unsigned c, int bits) {
+    return leaf[c * bits >> 3] >> (c * bits & 7) & ((1 << bits) - 1);
+}
+
+/*
+ * Emits three stage trie of n values that are each bits wide, where
+ * the top stage is indexed by c>>s1, the middle by c>>s2 & (1<<s1-s2)-1
+ * and the leaves hold 1<<s2 values packed into bytes.
+ */
+static void EmitTrie(struct buf *b, const char *name, const unsigned char *val, unsigned n,
+                     int bits, int s1, int s2) {
+    size_t i, leaves, mids, leafsize, midsize;
+    unsigned c, x, *leafidx, *mididx;
+    unsigned char *leaf, *mid, *top;
+    leafsize = (1u << s2) * bits / 8;
+    midsize = 1u << (s1 - s2);
+    leaf = (unsigned char *)calloc(n * bits / 8, 1);
+    mid = (unsigned char *)calloc(n >> s2, 1);
+    top = (unsigned char *)calloc(n >> s1, 1);
+    leafidx = (unsigned *)calloc(n >> s2, sizeof(unsigned));
+    mididx = (unsigned *)calloc(n >> s1, sizeof(unsigned));
+    for (c = 0; c < n; ++c)
+        leaf[c * bits >> 3] |= val[c] << (c * bits & 7);
+    leaves = Dedupe(leaf, n >> s2, leafsize, leafidx);
+    for (i = 0; i < n >> s2; ++i)
+        mid[i] = leafidx[i];
+    mids = Dedupe(mid, n >> s1, midsize, mididx);
+    for (i = 0; i < n >> s1; ++i)
+        top[i] = mididx[i];
+    if (leaves > 256 || mids > 256) {
+        fprintf(stderr, "mkunicode: %s trie overflowed a byte index\n", name);
+        exit(1);
+    }
+    for (c = 0; c < n; ++c) {
+        x = mid[top[c >> s1] * midsize + (c >> s2 & (midsize - 1))];
+        if (GetPacked(leaf + x * leafsize, c & ((1u << s2) - 1), bits) != val[c]) {
+            fprintf(stderr, "mkunicode: %s trie mismatch at %#x\n", name, c);
+            exit(1);
+        }
+    }
+    Appendv(b, "static const unsigned char %sStage1[", name);
+    Appendf(b, "%#x] = {", n >> s1);
+    AppendBytes(b, top, n >> s1, 0);
+    Appends(b, "\n};\n\n");
+    Appendv(b, "static const unsigned char %sStage2[", name);
+    Appendf(b, "%u]", mids);
+    Appendf(b, "[%u] = {", midsize);
+    for (i = 0; i < mids; ++i) {
+        AppendBytes(b, mid + i * midsize, midsize, 1);
+    }
+    Appends(b, "\n};\n\n");
+    Appendv(b, "static const unsigned char %sStage3[", name);
+    Appendf(b, "%u]", leaves);
+    Appendf(b, "[%u] = {", leafsize);
+    for (i = 0; i < leaves; ++i) {
+        AppendBytes(b, leaf + i * leafsize, leafsize, 1);
+    }
+    Appends(b, "\n};\n");
+    fprintf(stderr, "mkunicode: %s trie is %zu bytes\n", name,
+            (size_t)(n >> s1) + mids * midsize + leaves * leafsize);
+    free(mididx);
+    free(leafidx);
+    free(top);
+    free(mid);
+    free(leaf);
+}
+
+static void EmitDelta(struct buf *b) {
+    size_t i;
+    unsigned c, n;
+    for (n = c = 0; c < kMaxRune; ++c) {
+        for (i = 0; i < nrows; ++i) {
+            if (!memcmp(rows[i], delta[c], sizeof(rows[i])))
+                break;
+        }
+        if (i == nrows) {
+            if (nrows == 256) {
+                fprintf(stderr, "mkunicode: too many distinct delta rows\n");
+                exit(1);
+            }
+            memcpy(rows[nrows++], delta[c], sizeof(rows[i]));
+        }
+        if ((deltaidx[c] = i))
+            n = c + 1;
+    }
+    n = (n + 511) & -512;
+    EmitTrie(b, "kDelta", deltaidx, n, 8, 9, 4);
+    Appendf(b, "\nstatic const unsigned short kDelta[%u][5] = {", nrows);
+    for (i = 0; i < nrows; ++i) {
+        Appends(b, i % 2 ? " " : "\n    ");
+        Appendf(b, "{0x%04x, ", rows[i][0]);
+        Appendf(b, "0x%04x, ", rows[i][1]);
+        Appendf(b, "0x%04x, ", rows[i][2]);
+        Appendf(b, "0x%04x, ", rows[i][3]);
+        Appendf(b, "0x%04x},", rows[i][4]);
+    }
+    Appends(b, "\n};\n");
+    fprintf(stderr, "mkunicode: kDelta rows are %zu bytes\n", nrows * 10);
+}
+
+static char *Slurp(const char *path) {
+    FILE *f;
+    long size;
+    char *src;
+    if (!(f = fopen(path, "rb")) || fseek(f, 0, SEEK_END) || (size = ftell(f)) < 0 ||
+        fseek(f, 0, SEEK_SET) || !(src = (char *)malloc(size + 1)) ||
+        fread(src, 1, size, f) != (size_t)size) {
+        perror(path);
+        exit(1);
+    }
+    fclose(f);
+    src[size] = 0;
+    return src;
+}
+
+static unsigned GetDelta(const char *path, unsigned c, unsigned x) {
+    if ((c ^ x) >> 16 || c == x) {
+        fprintf(stderr, "%s: mapping %#x -> %#x can't be a delta\n", path, c, x);
+        exit(1);
+    }
+    return (x - c) & 0xffff;
+}
+
+/*
+ * Reads UnicodeData.txt, which has one semicolon separated line per
+ * codepoint where field 2 is General_Category and fields 12 and 13
+ * are the simple uppercase and lowercase mappings. Large blocks like
+ * CJK are a pair of lines whose names end with "First>" and "Last>".
+ * Controls, enclosing and nonspacing marks, and format characters
+ * other than SOFT HYPHEN are zero width.
+ */
+static void ReadUnicodeData(const char *path) {
+    int i;
+    char *data, *p, *e, *q, *f[15];
+    unsigned c, x, first;
+    data = Slurp(path);
+    for (first = -1u, p = data; *p; p = e + !!*e) {
+        e = p + strcspn(p, "\n");
+        for (f[i = 0] = p; i < 14 && (q = (char *)memchr(f[i], ';', e - f[i]));)
+            f[++i] = q + 1;
+        if (i < 14)
+            continue;
+        if ((c = strtoul(f[0], 0, 16)) >= kMaxRune) {
+            fprintf(stderr, "%s: bad codepoint %#x\n", path, c);
+            exit(1);
+        }
+        if (f[2] - f[1] > 7 && !strncmp(f[2] - 7, "First>", 6)) {
+            first = c;
+            continue;
+        }
+        if (f[2] - f[1] < 6 || strncmp(f[2] - 6, "Last>", 5))
+            first = c;
+        for (x = first; x <= c; ++x) {
+            word[x] = f[2][0] == 'L' || f[2][0] == 'N' || f[2][0] == 'M' ||
+                      !strncmp(f[2], "So;", 3);
+            if (!strncmp(f[2], "Mn;", 3) || !strncmp(f[2], "Me;", 3) ||
+                !strncmp(f[2], "Cc;", 3) || (!strncmp(f[2], "Cf;", 3) && x != 0x00ad))
+                width[x] = 0;
+        }
+        if (*f[12] != ';')
+            delta[c][1] = GetDelta(path, c, strtoul(f[12], 0, 16));
+        if (*f[13] != ';')
+            delta[c][0] = GetDelta(path, c, strtoul(f[13], 0, 16));
+        first = -1u;
+    }
+    free(data);
+}
+
+/*
+ * Reads BidiBrackets.txt, whose lines look like "0028; 0029; o # ..."
+ * which says the opening bracket U+0028 pairs with U+0029.
+ */
+static void ReadBidiBrackets(const char *path) {
+    char *data, *p, *e, *q;
+    unsigned c, x;
+    data = Slurp(path);
+    for (p = data; *p; p = e + !!*e) {
+        e = p + strcspn(p, "\n");
+        if (*p == '#' || p == e)
+            continue;
+        c = strtoul(p, &q, 16);
+        x = strtoul(q + 1, &q, 16);
+        q += strspn(q, "; ");
+        if (c >= kMaxRune || (*q != 'o' && *q != 'c')) {
+            fprintf(stderr, "%s: bad line\n", path);
+            exit(1);
+        }
+        delta[c][*q == 'c' ? 2 : 3] = GetDelta(path, c, x);
+    }
+    free(data);
+}
+
+/*
+ * Reads CaseFolding.txt, whose lines look like "0041; C; 0061; # ..."
+ * where we only want the C and S statuses, which together are the
+ * simple case folding that maps each codepoint to a single codepoint.
+ */
+static void ReadCaseFolding(const char *path) {
+    char *data, *p, *e, *q;
+    unsigned c, x;
+    data = Slurp(path);
+    for (p = data; *p; p = e + !!*e) {
+        e = p + strcspn(p, "\n");
+        if (*p == '#' || p == e)
+            continue;
+        c = strtoul(p, &q, 16);
+        q += strspn(q, "; ");
+        if (c >= kMaxRune || !*q || !strchr("CFST", *q)) {
+            fprintf(stderr, "%s: bad line\n", path);
+            exit(1);
+        }
+        if (*q == 'C' || *q == 'S') {
+            x = strtoul(q + 2, 0, 16);
+            delta[c][4] = GetDelta(path, c, x);
+        }
+    }
+    free(data);
+}
+
+/*
+ * Reads a UCD property file whose lines look like "0600..0605 ; Prepend"
+ * calling f for each codepoint in the range with the value's name.
+ */
+static void ReadProperty(const char *path, void f(unsigned, const char *, size_t)) {
+    size_t n;
+    unsigned a, b;
+    char *data, *p, *e, *q;
+    data = Slurp(path);
+    for (p = data; *p; p = e + !!*e) {
+        e = p + strcspn(p, "\n");
+        if (*p == '#' || p == e)
+            continue;
+        a = b = strtoul(p, &q, 16);
+        if (q[0] == '.' && q[1] == '.')
+            b = strtoul(q + 2, &q, 16);
+        q += strspn(q, " ;");
+        n = strcspn(q, " #\n");
+        if (b >= kMaxRune || a > b || !n) {
+            fprintf(stderr, "%s: bad line\n", path);
+            exit(1);
+        }
+        for (; a <= b; ++a)
+            f(a, q, n);
+    }
+    free(data);
+}
+
+/*
+ * Hangul medial vowels and final consonants are zero width too, since
+ * they're drawn inside the syllable block of the leading consonant.
+ * Prepended concatenation marks like U+0600 are format characters we
+ * still give a column, since they're drawn beneath the digits after.
+ */
+static void OnGraphemeBreak(unsigned c, const char *s, size_t n) {
+    unsigned i;
+    for (i = 0; i < sizeof(kGraphemeNames) / sizeof(*kGraphemeNames) - 1; ++i) {
+        if (strlen(kGraphemeNames[i]) == n && !memcmp(kGraphemeNames[i], s, n)) {
+            grapheme[c] = i;
+            if (n == 1 && (*s == 'V' || *s == 'T'))
+                width[c] = 0;
+            if (n == 7 && !memcmp(s, "Prepend", n))
+                width[c] = 1;
+            return;
+        }
+    }
+    fprintf(stderr, "mkunicode: unknown Grapheme_Cluster_Break %.*s\n", (int)n, s);
+    exit(1);
+}
+
+static void OnEmoji(unsigned c, const char *s, size_t n) {
+    if (n == 21 && !memcmp(s, "Extended_Pictographic", n)) {
+        if (grapheme[c]) {
+            fprintf(stderr, "mkunicode: pictographic %#x isn't Other\n", c);
+            exit(1);
+        }
+        grapheme[c] = sizeof(kGraphemeNames) / sizeof(*kGraphemeNames) - 1;
+    }
+}
+
+/*
+ * Makes Wide and Fullwidth codepoints double width, unless they've
+ * already been found to be zero width, e.g. U+302A..U+302D.
+ */
+static void OnEastAsianWidth(unsigned c, const char *s, size_t n) {
+    if (n == 1 && (*s == 'W' || *s == 'F') && width[c])
+        width[c] = 2;
+}
+
+static void EmitGraphemeEnum(struct buf *b) {
+    size_t i, j;
+    Appends(b, "enum {\n");
+    for (i = 0; i < sizeof(kGraphemeNames) / sizeof(*kGraphemeNames); ++i) {
+        Appends(b, "    kGrapheme");
+        for (j = 0; kGraphemeNames[i][j]; ++j) {
+            if (kGraphemeNames[i][j] == '_')
+                continue;
+            Append(b, kGraphemeNames[i] + j, 1);
+        }
+        Appends(b, ",\n");
+    }
+    Appends(b, "};\n\n");
+}
+
+static void Splice(const char *path, struct buf *tables) {
+    FILE *f;
+    struct buf b = {0};
+    char *src, *begin, *end;
+    src = Slurp(path);
+    if (!(begin = strstr(src, kBegin)) || !(end = strstr(begin, kEnd))) {
+        fprintf(stderr, "%s: missing generated table markers\n", path);
+        exit(1);
+    }
+    Append(&b, src, begin + strlen(kBegin) - src);
+    Append(&b, tables->p, tables->n);
+    Appends(&b, end);
+    if (!(f = fopen(path, "wb")) || fwrite(b.p, 1, b.n, f) != b.n || fclose(f)) {
+        perror(path);
+        exit(1);
+    }
+    free(b.p);
+    free(src);
+}
+
+static const char *Join(struct buf *b, const char *dir, const char *name) {
+    b->n = 0;
+    Appends(b, dir);
+    Appends(b, "/");
+    Appends(b, name);
+    return b->p;
+}
+
+int main(int argc, char *argv[]) {
+    struct buf path = {0}, tables = {0};
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s UCDDIR bestline.c\n", argv[0]);
+        return 1;
+    }
+    memset(width, 1, sizeof(width));
+    ReadUnicodeData(Join(&path, argv[1], "UnicodeData.txt"));
+    ReadBidiBrackets(Join(&path, argv[1], "BidiBrackets.txt"));
+    ReadCaseFolding(Join(&path, argv[1], "CaseFolding.txt"));
+    ReadProperty(Join(&path, argv[1], "GraphemeBreakProperty.txt"), OnGraphemeBreak);
+    ReadProperty(Join(&path, argv[1], "emoji-data.txt"), OnEmoji);
+    ReadProperty(Join(&path, argv[1], "EastAsianWidth.txt"), OnEastAsianWidth);
+    EmitTrie(&tables, "kWidth", width, kMaxRune, 2, 12, 6);
+    Appends(&tables, "\n");
+    EmitTrie(&tables, "kWord", word, kMaxRune, 1, 12, 7);
+    Appends(&tables, "\n");
+    EmitDelta(&tables);
+    Appends(&tables, "\n");
+    EmitGraphemeEnum(&tables);
+    EmitTrie(&tables, "kGrapheme", grapheme, kMaxRune, 4, 12, 6);
+    Splice(argv[2], &tables);
+    free(tables.p);
+    free(path.p);
+    return 0;
+}